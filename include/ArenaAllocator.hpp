@@ -0,0 +1,230 @@
+#ifndef ARENAALLOCATOR_HPP
+#define ARENAALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+
+// CURRENT VERSION v0.1.0
+
+// Монотонная арена: память выдается сдвигом указателя внутри крупных блоков
+// и не освобождается поштучно. Все блоки возвращаются разом в release() или в деструкторе.
+//
+//     mystl::Arena arena;                                        // на один запрос
+//     mystl::DynamicArray<int, mystl::ArenaAllocator<int>> a{mystl::ArenaAllocator<int>(arena)};
+//     mystl::Map<int, int, std::less<int>, mystl::ArenaAllocator<std::pair<const int, int>>> m(arena);
+//     ...
+//     arena.release();                                           // все контейнеры уже уничтожены
+//
+// Контейнеры, созданные на арене, должны быть уничтожены до release().
+
+namespace mystl {
+
+/**
+ * @brief Arena - монотонный источник памяти
+ *
+ * Не потокобезопасна. Не копируется и не перемещается: аллокаторы хранят на нее указатель.
+ */
+class Arena {
+private:
+
+    // Заголовок блока, полученного из operator new. Данные идут сразу за ним
+    struct Chunk {
+        Chunk* next;
+        std::size_t size;  // размер блока вместе с заголовком
+    };
+
+    static constexpr std::size_t min_chunk_size = 4096;
+
+    Chunk* chunks_ = nullptr;
+
+    std::byte* cur_ = nullptr;  // первый свободный байт текущего блока
+    std::byte* end_ = nullptr;  // конец текущего блока
+
+    // Внешний буфер, с которого арена начинает (может отсутствовать)
+    std::byte* initial_buffer_ = nullptr;
+    std::size_t initial_size_ = 0;
+
+    std::size_t next_chunk_size_;
+
+    /**
+     * @brief align_up - выравнивание указателя вверх
+     *
+     * @return std::byte* - выровненный указатель или nullptr, если он выходит за end_
+     */
+    std::byte* align_up(std::byte* p, std::size_t align) const noexcept {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        std::uintptr_t aligned = (addr + align - 1) & ~(std::uintptr_t(align) - 1);
+        if (aligned < addr || aligned > reinterpret_cast<std::uintptr_t>(end_)) return nullptr;
+        return p + (aligned - addr);
+    }
+
+    /**
+     * @brief grow - заводит новый блок, в который гарантированно поместится bytes с выравниванием align
+     *
+     * Размеры блоков растут вдвое, чтобы число обращений к operator new было логарифмическим.
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    void grow(std::size_t bytes, std::size_t align) {
+        std::size_t header = sizeof(Chunk) + align;
+        if (bytes > std::numeric_limits<std::size_t>::max() - header) throw std::bad_alloc();
+
+        std::size_t size = std::max(next_chunk_size_, bytes + header);
+        void* raw = ::operator new(size);
+
+        Chunk* chunk = static_cast<Chunk*>(raw);
+        chunk->next = chunks_;
+        chunk->size = size;
+        chunks_ = chunk;
+
+        cur_ = reinterpret_cast<std::byte*>(chunk + 1);
+        end_ = static_cast<std::byte*>(raw) + size;
+
+        if (next_chunk_size_ <= std::numeric_limits<std::size_t>::max() / 2) next_chunk_size_ *= 2;
+    }
+
+public:
+
+    /**
+     * @brief Arena - конструктор
+     *
+     * @param initial_chunk_size - размер первого блока, который будет запрошен у operator new
+     */
+    explicit Arena(std::size_t initial_chunk_size = min_chunk_size) noexcept
+        : next_chunk_size_(std::max(initial_chunk_size, min_chunk_size)) {}
+
+    /**
+     * @brief Arena - конструктор от внешнего буфера
+     *
+     * Пока буфера хватает, куча не используется (например, буфер на стеке).
+     *
+     * @param buffer - указатель на буфер
+     * @param size - размер буфера
+     */
+    Arena(void* buffer, std::size_t size) noexcept
+        : cur_(static_cast<std::byte*>(buffer)),
+        end_(static_cast<std::byte*>(buffer) + size),
+        initial_buffer_(static_cast<std::byte*>(buffer)),
+        initial_size_(size),
+        next_chunk_size_(std::max(size, min_chunk_size)) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator = (const Arena&) = delete;
+
+    /**
+     * @brief Деструктор - освобождает все блоки
+     */
+    ~Arena() { release(); }
+
+    /**
+     * @brief allocate - выделение bytes байт с выравниванием align
+     *
+     * @param bytes - размер
+     * @param align - выравнивание (степень двойки)
+     *
+     * @return void* - указатель на память
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        std::byte* p = cur_ ? align_up(cur_, align) : nullptr;
+        if (p == nullptr || static_cast<std::size_t>(end_ - p) < bytes) {
+            grow(bytes, align);
+            p = align_up(cur_, align);
+        }
+        cur_ = p + bytes;
+        return p;
+    }
+
+    /**
+     * @brief deallocate - ничего не делает: память вернется в release()
+     */
+    void deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) noexcept {}
+
+    /**
+     * @brief release - освобождает все блоки и возвращает арену в исходное состояние
+     *
+     * Все указатели, выданные ареной, становятся невалидными.
+     */
+    void release() noexcept {
+        while (chunks_ != nullptr) {
+            Chunk* next = chunks_->next;
+            ::operator delete(static_cast<void*>(chunks_));
+            chunks_ = next;
+        }
+        cur_ = initial_buffer_;
+        end_ = initial_buffer_ ? initial_buffer_ + initial_size_ : nullptr;
+    }
+};
+
+/**
+ * @brief ArenaAllocator - аллокатор, берущий память у Arena
+ *
+ * deallocate() ничего не делает, поэтому освобождение контейнера почти бесплатно.
+ * Аллокатор не распространяется при присваивании и swap (как std::pmr::polymorphic_allocator):
+ * контейнер остается на той арене, на которой был создан.
+ *
+ * @tparam T - тип элементов
+ */
+template<typename T>
+class ArenaAllocator {
+private:
+
+    template<typename> friend class ArenaAllocator;
+
+    Arena* arena_;
+
+public:
+
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    /**
+     * @brief ArenaAllocator - конструктор от арены
+     *
+     * @param arena - арена, которая должна пережить все контейнеры с этим аллокатором
+     */
+    ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {}
+
+    /**
+     * @brief ArenaAllocator - конструктор из аллокатора другого типа (rebind)
+     */
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+    /**
+     * @brief allocate - выделение памяти под n объектов T
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief deallocate - ничего не делает
+     */
+    void deallocate(T* p, std::size_t n) noexcept { arena_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    /**
+     * @brief arena - арена, из которой берется память
+     */
+    Arena& arena() const noexcept { return *arena_; }
+
+    template<typename U>
+    bool operator == (const ArenaAllocator<U>& other) const noexcept { return arena_ == other.arena_; }
+};
+
+} // namespace mystl
+
+#endif // ARENAALLOCATOR_HPP
@@ -0,0 +1,310 @@
+#ifndef ARRAYALGORITHMS_HPP
+#define ARRAYALGORITHMS_HPP
+
+#include <type_traits>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <cstring>
+#include <cstddef>
+
+#include "Relocation.hpp"
+
+// CURRENT VERSION v0.1.0
+
+// Общие алгоритмы вставки/удаления для контейнеров с непрерывным хранением
+// (DynamicArray, StaticArray). Работают с сырым буфером arr и его размером sz,
+// ничего не зная о том, где лежит буфер и кто им владеет.
+// Все функции constexpr: при вычислении на этапе компиляции memcpy/memmove
+// заменяются поэлементными операциями.
+
+namespace mystl {
+
+/**
+ * @brief default_init - тег для конструкторов DynamicArray(size, default_init) и StaticArray(size, default_init):
+ *        элементы инициализируются по умолчанию, а не значением
+ */
+struct default_init_t { explicit default_init_t() = default; };
+inline constexpr default_init_t default_init{};
+
+} // namespace mystl
+
+namespace mystl::detail {
+
+/**
+ * @brief fill_iterator - итератор, n раз возвращающий одно и то же значение (для insert(pos, n, value))
+ */
+template<typename T>
+class fill_iterator {
+private:
+
+    const T* value_ = nullptr;
+    std::ptrdiff_t pos_ = 0;
+
+public:
+
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = const T&;
+    using pointer           = const T*;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr fill_iterator() = default;
+    constexpr fill_iterator(const T* value, std::ptrdiff_t pos) : value_(value), pos_(pos) {}
+
+    constexpr const T& operator * () const { return *value_; }
+    constexpr fill_iterator& operator ++ () { ++pos_; return *this; }
+    constexpr fill_iterator operator ++ (int) { fill_iterator copy = *this; ++pos_; return copy; }
+    constexpr bool operator == (const fill_iterator& other) const { return pos_ == other.pos_; }
+};
+
+/**
+ * @brief temporary_value - элемент вне массива, созданный через аллокатор
+ *
+ * Нужен emplace(): аргументы могут ссылаться на элементы самого массива,
+ * которые затрет сдвиг хвоста или перевыделение памяти.
+ */
+template<typename T, typename Allocator>
+class temporary_value {
+private:
+
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    Allocator& alloc_;
+    union storage {
+        constexpr storage() {}
+        constexpr ~storage() {}
+        T value_;
+    } storage_;
+
+public:
+
+    template<typename... Args>
+    constexpr temporary_value(Allocator& alloc, Args&&... args) : alloc_(alloc) {
+        AllocatorTraits::construct(alloc_, &storage_.value_, std::forward<Args>(args)...);
+    }
+
+    constexpr ~temporary_value() { AllocatorTraits::destroy(alloc_, &storage_.value_); }
+
+    temporary_value(const temporary_value&) = delete;
+    temporary_value& operator = (const temporary_value&) = delete;
+
+    constexpr T& get() noexcept { return storage_.value_; }
+};
+
+/**
+ * @brief copies_bitwise - можно ли копировать элементы из ForwardIt в T* через memcpy/memmove
+ */
+template<typename ForwardIt, typename T, typename Allocator>
+inline constexpr bool copies_bitwise =
+    std::contiguous_iterator<ForwardIt> &&
+    std::is_same_v<std::iter_value_t<ForwardIt>, T> &&
+    std::is_trivially_copyable_v<T> &&
+    allocator_relocates_bitwise_v<T, Allocator>;
+
+/**
+ * @brief construct_n_from - конструирует n элементов из диапазона first в неинициализированной памяти dest
+ *
+ * @param alloc - аллокатор
+ * @param first - итератор на начало диапазона
+ * @param n - количество элементов
+ * @param dest - указатель на неинициализированную память
+ *
+ * @exception Любые исключения от конструктора T. Уже созданные элементы при этом уничтожаются
+ */
+template<typename T, typename Allocator, typename ForwardIt>
+constexpr void construct_n_from(Allocator& alloc, ForwardIt first, std::size_t n, T* dest) {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    if constexpr (copies_bitwise<ForwardIt, T, Allocator>) {
+        if (!std::is_constant_evaluated()) {
+            if (n != 0) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(std::to_address(first)), n * sizeof(T));
+            return;
+        }
+    }
+
+    std::size_t i = 0;
+    try {
+        for (; i < n; ++i, ++first) AllocatorTraits::construct(alloc, dest + i, *first);
+    } catch (...) {
+        for (std::size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, dest + j);
+        throw;
+    }
+}
+
+/**
+ * @brief assign_n_from - присваивает n элементов из диапазона first уже существующим элементам dest
+ *
+ * @exception Любые исключения от оператора присваивания T
+ */
+template<typename T, typename Allocator, typename ForwardIt>
+constexpr void assign_n_from(ForwardIt first, std::size_t n, T* dest) {
+    if constexpr (copies_bitwise<ForwardIt, T, Allocator>) {
+        if (!std::is_constant_evaluated()) {
+            if (n != 0) std::memmove(static_cast<void*>(dest), static_cast<const void*>(std::to_address(first)), n * sizeof(T));
+            return;
+        }
+    }
+    std::copy_n(first, n, dest);
+}
+
+/**
+ * @brief move_construct_n - перемещает n элементов из src в неинициализированную память dest
+ *
+ * @exception Любые исключения от конструктора перемещения T. Уже созданные элементы при этом уничтожаются
+ */
+template<typename T, typename Allocator>
+constexpr void move_construct_n(Allocator& alloc, T* src, std::size_t n, T* dest) {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    std::size_t i = 0;
+    try {
+        for (; i < n; ++i) AllocatorTraits::construct(alloc, dest + i, std::move(src[i]));
+    } catch (...) {
+        for (std::size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, dest + j);
+        throw;
+    }
+}
+
+/**
+ * @brief default_construct_n - инициализирует по умолчанию n элементов в неинициализированной памяти dest
+ *
+ * Если аллокатор не переопределяет construct(), используется default-init (T без скобок):
+ * для тривиальных типов это не генерирует ни одной инструкции.
+ *
+ * @exception Любые исключения от дефолтного конструктора T. Уже созданные элементы при этом уничтожаются
+ */
+template<typename T, typename Allocator>
+constexpr void default_construct_n(Allocator& alloc, T* dest, std::size_t n) {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    constexpr bool allocator_constructs = requires(Allocator& a, T* p) { a.construct(p); };
+
+    if constexpr (std::is_trivially_default_constructible_v<T> && !allocator_constructs) {
+        if (!std::is_constant_evaluated()) return;
+    }
+
+    std::size_t i = 0;
+    try {
+        for (; i < n; ++i) {
+            if constexpr (allocator_constructs) AllocatorTraits::construct(alloc, dest + i);
+            else if (std::is_constant_evaluated()) std::construct_at(dest + i);
+            else ::new (static_cast<void*>(dest + i)) T;
+        }
+    } catch (...) {
+        for (std::size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, dest + j);
+        throw;
+    }
+}
+
+/**
+ * @brief insert_n_in_place - вставляет n элементов из диапазона first в позицию idx без перевыделения
+ *
+ * Ёмкости буфера должно хватать на sz + n элементов. Хвост сдвигается ровно один раз:
+ * для побайтово переносимых T - одним memmove, иначе - перемещающим конструированием
+ * в неинициализированную память и move_backward.
+ *
+ * @param alloc - аллокатор
+ * @param arr - буфер
+ * @param sz - текущий размер (увеличивается на n)
+ * @param idx - позиция вставки
+ * @param first - итератор на начало вставляемого диапазона (не должен указывать внутрь буфера)
+ * @param n - количество вставляемых элементов
+ *
+ * @return T* - указатель на первый вставленный элемент
+ *
+ * @exception Любые исключения от конструктора T или перемещения элементов
+ */
+template<typename T, typename Allocator, typename ForwardIt>
+constexpr T* insert_n_in_place(Allocator& alloc, T* arr, std::size_t& sz, std::size_t idx, ForwardIt first, std::size_t n) {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    T* pos = arr + idx;
+    std::size_t tail = sz - idx;
+
+    if (n == 0) return pos;
+
+    if constexpr (allocator_relocates_bitwise_v<T, Allocator>) {
+        if (!std::is_constant_evaluated()) {
+            if (tail != 0) std::memmove(static_cast<void*>(pos + n), static_cast<const void*>(pos), tail * sizeof(T));
+            try {
+                construct_n_from(alloc, first, n, pos);
+            } catch (...) {
+                if (tail != 0) std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos + n), tail * sizeof(T));
+                throw;
+            }
+            sz += n;
+            return pos;
+        }
+    }
+
+    T* old_end = arr + sz;
+    if (tail > n) {
+        //  [pos .. old_end - n) [old_end - n .. old_end) [raw]
+        //           ↓ move_backward          ↓ move_construct
+        move_construct_n(alloc, old_end - n, n, old_end);
+        sz += n;
+        std::move_backward(pos, old_end - n, old_end);
+        assign_n_from<T, Allocator>(first, n, pos);
+    } else {
+        //  [pos .. old_end) [raw ......................]
+        //   ↑ assign           ↑ construct(mid..)  ↑ move_construct
+        ForwardIt mid = std::next(first, tail);
+        construct_n_from(alloc, mid, n - tail, old_end);
+        sz += n - tail;
+        try {
+            move_construct_n(alloc, pos, tail, arr + sz);
+        } catch (...) {
+            for (std::size_t j = 0; j < n - tail; ++j) AllocatorTraits::destroy(alloc, old_end + j);
+            sz -= n - tail;
+            throw;
+        }
+        sz += tail;
+        assign_n_from<T, Allocator>(first, tail, pos);
+    }
+    return pos;
+}
+
+/**
+ * @brief erase_range - удаляет диапазон [beg, end) из буфера arr размера sz
+ *
+ * @param alloc - аллокатор
+ * @param arr - буфер
+ * @param sz - текущий размер (уменьшается на end - beg)
+ * @param beg - указатель на начало удаляемого диапазона
+ * @param end - указатель на конец удаляемого диапазона
+ *
+ * @return T* - указатель на позицию после удаления
+ *
+ * @exception Может бросать исключения от оператора перемещения T
+ */
+template<typename T, typename Allocator>
+constexpr T* erase_range(Allocator& alloc, T* arr, std::size_t& sz, T* beg, T* end) {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    std::size_t diff = end - beg;
+
+    if (diff == 0) return end;
+
+    T* old_end = arr + sz;
+
+    if constexpr (allocator_relocates_bitwise_v<T, Allocator>) {
+        if (!std::is_constant_evaluated()) {
+            // Удаляемые уничтожаем, хвост переносим вниз одним memmove
+            for (T* p = beg; p != end; ++p) AllocatorTraits::destroy(alloc, p);
+            std::memmove(static_cast<void*>(beg), static_cast<const void*>(end), (old_end - end) * sizeof(T));
+            sz -= diff;
+            return beg;
+        }
+    }
+
+    std::move(end, old_end, beg);
+    for (T* p = old_end - diff; p != old_end; ++p) AllocatorTraits::destroy(alloc, p);
+
+    sz -= diff;
+    return beg;
+}
+
+} // namespace mystl::detail
+
+#endif // ARRAYALGORITHMS_HPP
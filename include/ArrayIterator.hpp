@@ -0,0 +1,112 @@
+#ifndef ARRAYITERATOR_HPP
+#define ARRAYITERATOR_HPP
+
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+
+// CURRENT VERSION v0.1.0
+
+namespace mystl {
+
+/**
+ * @brief array_iterator - итератор по непрерывному массиву элементов T
+ *
+ * Общий для всех контейнеров с непрерывным хранением (DynamicArray, StaticArray),
+ * внутри которых он доступен как common_iterator<IsConst>.
+ *
+ * @tparam T - тип элемента
+ * @tparam IsConst - константный ли итератор
+ */
+template <typename T, bool IsConst>
+class array_iterator {
+private:
+
+    template <typename, bool>
+    friend class array_iterator;
+
+    using ConditionalPtr = std::conditional_t<IsConst, const T*, T*>;
+    using ConditionalRef = std::conditional_t<IsConst, const T&, T&>;
+    using ConditionalType = std::conditional_t<IsConst, const T, T>;
+
+    ConditionalPtr ptr;
+
+public:
+
+    using value_type        = ConditionalType;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = ConditionalRef;
+    using pointer           = ConditionalPtr;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::contiguous_iterator_tag;    // элементы лежат подряд -> std::to_address, memcpy
+
+    /**
+     * @brief Преобразование обычного итератора в константный
+     *
+     * @param other - неконстантный итератор
+     */
+    constexpr array_iterator(const array_iterator<T, false>& other) noexcept
+    requires IsConst
+    : ptr(other.base()) {}
+
+    /**
+     * @brief Конструктор из сырого указателя
+     *
+     * @param p - std::conditional_t<IsConst, const T*, T*>
+     */
+    constexpr array_iterator(ConditionalPtr p) noexcept : ptr(p) {}
+
+    constexpr array_iterator() = default;
+    constexpr ~array_iterator() = default;
+
+    constexpr reference operator * () const { return *ptr; }                                            // Input
+    constexpr pointer operator -> () const { return ptr; }                                              // iterator
+    template <bool OtherConst>                                                                          // properties
+    constexpr bool operator == (const array_iterator<T, OtherConst>& other) const                       //
+    { return ptr == other.ptr; }                                                                        //
+    template <bool OtherConst>                                                                          //
+    constexpr bool operator != (const array_iterator<T, OtherConst>& other) const                       //
+    { return ptr != other.ptr; }                                                                        //
+    constexpr array_iterator& operator ++ () { ++ptr; return *this; }                                   //
+    constexpr array_iterator operator ++ (int) {                                                        //
+        array_iterator copy = *this;                                                                    //
+        ++(*this);                                                                                      //
+        return copy;                                                                                    //
+    }                                                                                                   //
+
+    constexpr array_iterator(const array_iterator& other) = default;                                    // Forward
+    constexpr array_iterator& operator = (const array_iterator& other) = default;                       // iterator
+                                                                                                        // properties
+
+    constexpr array_iterator& operator -- () { --ptr; return *this; }                                   // Bidirectional
+    constexpr array_iterator operator -- (int) {                                                        // iterator
+        array_iterator copy = *this;                                                                    // properties
+        --(*this);                                                                                      //
+        return copy;                                                                                    //
+    }                                                                                                   //
+
+    constexpr array_iterator operator + (difference_type n) const { return array_iterator(ptr + n); }   // Random
+    constexpr array_iterator operator - (difference_type n) const { return array_iterator(ptr - n); }   // access
+    constexpr array_iterator& operator += (difference_type n) { ptr += n; return *this; }               // iterator
+    constexpr array_iterator& operator -= (difference_type n) { ptr -= n; return *this; }               // properties
+    constexpr bool operator < (const array_iterator& other) const { return ptr < other.ptr; }           //
+    constexpr bool operator > (const array_iterator& other) const { return ptr > other.ptr; }           //
+    constexpr bool operator <= (const array_iterator& other) const { return ptr <= other.ptr; }         //
+    constexpr bool operator >= (const array_iterator& other) const { return ptr >= other.ptr; }         //
+    constexpr difference_type operator - (const array_iterator& other) const                            //
+    { return ptr - other.ptr; }                                                                         //
+    constexpr reference operator [] (difference_type n) const { return ptr[n]; }                        //
+    friend constexpr array_iterator operator + (difference_type n, const array_iterator& it)            //
+    { return array_iterator(it.ptr + n); }                                                              //
+
+    /**
+     * @brief Геттер, возвращающий сырой указатель
+     *
+     * @return std::conditional_t<IsConst, const T*, T*>
+     */
+    constexpr ConditionalPtr base() const noexcept { return ptr; }
+};
+
+} // namespace mystl
+
+#endif // ARRAYITERATOR_HPP
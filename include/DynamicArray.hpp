@@ -5,14 +5,48 @@
 #include <stdexcept>
 #include <initializer_list>
 #include <concepts>
-
-// CURRENT VERSION v0.1.0
-
-
-                                         /* ПОДМЕНА АЛЛОКАТОРА НЕ ТЕСТИРОВАЛАСЬ */
-namespace mystl {         //                            /
-                          //                          |/_
-template<typename T, typename Allocator = std::allocator<T>>
+#include <memory>
+#include <limits>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <algorithm>
+
+#include "Relocation.hpp"
+#include "GrowthPolicy.hpp"
+#include "ArrayIterator.hpp"
+#include "ArrayAlgorithms.hpp"
+
+// CURRENT VERSION v0.1.10
+
+// CHANGELOG:
+// > reserve() и shrink_to_fit() переносят тривиально переносимые типы одним memcpy
+// > Рост через realloc для std::allocator и тривиально переносимых типов
+// > Политика роста GrowthPolicy (GrowthPolicy.hpp), минимальная ёмкость первой аллокации
+// > Массовые insert(pos, first, last), insert(pos, n, value), append_range(), assign() и конструктор
+//   из диапазона с одним перевыделением памяти
+// > Итератор удовлетворяет std::contiguous_iterator
+// > emplace() и erase() сдвигают хвост одним memmove для тривиально переносимых типов,
+//   иначе - перемещающим конструированием в неинициализированную память
+// > Встроенный буфер InlineCapacity и псевдоним SmallDynamicArray<T, N>
+// > resize_for_overwrite(), resize_and_overwrite() и конструктор с тегом default_init
+// > Итератор и алгоритмы вставки/удаления вынесены в ArrayIterator.hpp и ArrayAlgorithms.hpp
+//   (общие со StaticArray)
+// > Учитываются propagate_on_container_* и аллокаторы с состоянием; конструкторы
+//   от аллокатора, копирования и перемещения с заданным аллокатором; get_allocator()
+// > append_range() принимает однопроходные sized-диапазоны с только перемещаемым итератором
+
+namespace mystl {
+
+template<
+    typename T,
+    typename Allocator = std::allocator<T>,
+    typename GrowthPolicy = DefaultGrowth,
+    size_t InlineCapacity = 0  // Сколько элементов хранится прямо в объекте до первой аллокации
+    >
+requires growth_policy<GrowthPolicy, T>
 class DynamicArray {
 private:
 
@@ -25,91 +59,25 @@ private:
 
     using AllocatorTraits = std::allocator_traits<Allocator>;
 
+    // Встроенный буфер на InlineCapacity элементов. Пока элементы в нем помещаются,
+    // arr указывает сюда и аллокатор не вызывается
+    struct inline_storage {
+        alignas(T) unsigned char bytes[InlineCapacity > 0 ? InlineCapacity * sizeof(T) : 1];
+    };
+    struct no_inline_storage {};
+
+    [[no_unique_address]]
+    std::conditional_t<InlineCapacity == 0, no_inline_storage, inline_storage> inline_buf;
+
     //COMMON ITERATOR BLOCK
 
     template <bool IsConst>
-    class common_iterator {
-    private:
-
-        using ConditionalPtr = std::conditional_t<IsConst, const T*, T*>;
-        using ConditionalRef = std::conditional_t<IsConst, const T&, T&>;
-        using ConditionalType = std::conditional_t<IsConst, const T, T>;
-
-        ConditionalPtr ptr;
-
-    public:
-
-        using value_type        = ConditionalType;
-        using difference_type   = std::ptrdiff_t;
-        using reference         = ConditionalRef;
-        using pointer           = ConditionalPtr;
-        using iterator_category = std::random_access_iterator_tag; // не знаю, как сделать contiguous
-
-        /**
-         * @brief Преобразование обычного итератора в константный
-         *
-         * @param other - неконстантный итератор
-         */
-        common_iterator(const common_iterator<false>& other)
-        requires IsConst
-        : ptr(other.base()) {}
-
-        /**
-         * @brief Конструктор из сырого указателя
-         *
-         * @param p - std::conditional_t<IsConst, const T*, T*>
-         */
-        common_iterator(ConditionalPtr p) : ptr(p) {}
-
-        common_iterator() = default;
-        ~common_iterator() = default;
-
-        ConditionalRef operator * () const { return *ptr; }                                          // Input
-        ConditionalPtr operator -> () const { return ptr; }                                          // iterator
-        template <bool OtherConst>                                                                   // properties
-        bool operator == (const common_iterator<OtherConst>& other) const {return ptr == other.ptr;} //
-        template <bool OtherConst>                                                                   //
-        bool operator != (const common_iterator<OtherConst>& other) const {return ptr != other.ptr;} //
-        common_iterator<IsConst>& operator ++ () { ++ptr; return *this; }                            //
-        common_iterator<IsConst> operator ++ (int) {                                                 //
-            common_iterator<IsConst> copy = *this;                                                   //
-            ++(*this);                                                                               //
-            return copy;                                                                             //
-        }                                                                                            //
-
-        common_iterator(const common_iterator& other) = default;                                     // Forward
-        common_iterator& operator=(const common_iterator& other) = default;                          // iterator
-                                                                                                     // properties
-
-        common_iterator<IsConst>& operator -- () { --ptr; return *this; }                            // Bidirectional
-        common_iterator<IsConst> operator -- (int) {                                                 // iterator
-            common_iterator<IsConst> copy = *this;                                                   // properties
-            --(*this);                                                                               //
-            return copy;                                                                             //
-        };                                                                                           //
-
-        common_iterator<IsConst> operator + (difference_type n) { return common_iterator(ptr + n); } // Random
-        common_iterator<IsConst> operator - (difference_type n) { return common_iterator(ptr - n); } // access
-        common_iterator<IsConst>& operator += (difference_type n) { ptr += n; return *this; }        // iterator
-        common_iterator<IsConst>& operator -= (difference_type n) { ptr -= n; return *this; }        // properties
-        bool operator < (const common_iterator<IsConst>& other) const { return ptr < other.ptr; }    //
-        bool operator > (const common_iterator<IsConst>& other) const { return ptr > other.ptr; }    //
-        bool operator <= (const common_iterator<IsConst>& other) const { return ptr <= other.ptr; }  //
-        bool operator >= (const common_iterator<IsConst>& other) const { return ptr >= other.ptr; }  //
-        difference_type operator - (const common_iterator<IsConst>& other) const                     //
-        { return ptr - other.ptr; }                                                                  //
-        ConditionalRef operator [] (difference_type n) const { return ptr[n]; }                      //
-
-        /**
-         * @brief Геттер, возвращающий сырой указатель
-         *
-         * @return std::conditional_t<IsConst, const T*, T*>
-         */
-        ConditionalPtr base() const noexcept { return ptr; }
-    };
+    using common_iterator = array_iterator<T, IsConst>;
 
 public:
 
+    using allocator_type = Allocator;
+
     //ORDINARY ITERATOR BLOCK
 
     using iterator = common_iterator<false>;
@@ -139,7 +107,16 @@ public:
      *
      * @exception Не бросает исключений
      */
-    DynamicArray() noexcept : arr(nullptr), sz(0), cap(0), alloc(Allocator()) {}
+    DynamicArray() noexcept : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(Allocator()) {}
+
+    /**
+     * @brief Конструктор от аллокатора. Создает пустой DynamicArray.
+     *
+     * @param alloc Аллокатор для управления памятью
+     *
+     * @exception Не бросает исключений
+     */
+    explicit DynamicArray(const Allocator& alloc) noexcept : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(alloc) {}
 
     /**
      * @brief Конструктор с заданным размером и значением (для копируемых типов).
@@ -153,7 +130,7 @@ public:
      */
     explicit DynamicArray(size_t size, const T& value = T(), Allocator alloc = Allocator())
     requires std::copy_constructible<T>
-        : arr(nullptr), sz(0), cap(0), alloc(alloc)
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(alloc)
     {
         reserve(size);
         sz = size;
@@ -163,7 +140,7 @@ public:
             for(i = 0; i < sz; ++i) AllocatorTraits::construct(alloc, arr + i, value);
         } catch (const std::exception&) {
             for (size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, arr + j);
-            AllocatorTraits::deallocate(alloc, arr, cap);
+            deallocate_storage(arr, cap);
             throw;
         }
     }
@@ -179,7 +156,7 @@ public:
      */
     explicit DynamicArray(size_t size, Allocator alloc = Allocator())
     requires (!std::copy_constructible<T> && std::default_initializable<T>)
-        : arr(nullptr), sz(0), cap(0), alloc(alloc)
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(alloc)
     {
         reserve(size);
         sz = size;
@@ -189,11 +166,37 @@ public:
             for(i = 0; i < sz; ++i) AllocatorTraits::construct(alloc, arr + i);
         } catch (const std::exception&) {
             for (size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, arr + j);
-            AllocatorTraits::deallocate(alloc, arr, cap);
+            deallocate_storage(arr, cap);
             throw;
         }
     }
 
+    /**
+     * @brief Конструктор с заданным размером без инициализации значением.
+     *
+     * Элементы инициализируются по умолчанию: для тривиальных типов память не трогается вовсе,
+     * что экономит полный проход по памяти, если массив сразу будет перезаписан.
+     *
+     * @param size Начальный размер массива
+     * @param alloc Аллокатор для управления памятью
+     *
+     * @exception std::bad_alloc При невозможности выделить память
+     * @exception Любые исключения от дефолтного конструктора T
+     */
+    DynamicArray(size_t size, default_init_t, Allocator alloc = Allocator())
+    requires std::default_initializable<T>
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(alloc)
+    {
+        reserve(size);
+        try {
+            detail::default_construct_n(alloc, arr, size);
+        } catch (...) {
+            deallocate_storage(arr, cap);
+            throw;
+        }
+        sz = size;
+    }
+
     /**
      * @brief Конструктор из списка инициализации.
      *
@@ -204,7 +207,7 @@ public:
      */
     DynamicArray(std::initializer_list<T> list)
     requires std::copy_constructible<T>
-        : arr(nullptr), sz(0), cap(0), alloc(Allocator())
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(Allocator())
     {
         reserve(list.size());
         sz = list.size();
@@ -216,11 +219,50 @@ public:
             }
         } catch (const std::exception&) {
             for (size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, arr + j);
-            AllocatorTraits::deallocate(alloc, arr, cap);
+            deallocate_storage(arr, cap);
             throw;
         }
     }
 
+    /**
+     * @brief Конструктор из диапазона [first, last).
+     *
+     * Для forward-итераторов размер вычисляется заранее и память выделяется один раз;
+     * тривиально копируемые элементы из непрерывного диапазона копируются одним memcpy.
+     *
+     * @param first Итератор на начало диапазона
+     * @param last Итератор на конец диапазона
+     * @param alloc Аллокатор для управления памятью
+     *
+     * @exception std::bad_alloc При невозможности выделить память
+     * @exception Любые исключения от конструктора T
+     */
+    template<std::input_iterator InputIt>
+    requires std::constructible_from<T, std::iter_reference_t<InputIt>>
+    DynamicArray(InputIt first, InputIt last, Allocator alloc = Allocator())
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(alloc)
+    {
+        if constexpr (std::forward_iterator<InputIt>) {
+            size_t n = static_cast<size_t>(std::distance(first, last));
+            reserve(n);
+            try {
+                detail::construct_n_from(alloc, first, n, arr);
+            } catch (...) {
+                deallocate_storage(arr, cap);
+                throw;
+            }
+            sz = n;
+        } else {
+            try {
+                for (; first != last; ++first) emplace_back(*first);
+            } catch (...) {
+                clear();
+                deallocate_storage(arr, cap);
+                throw;
+            }
+        }
+    }
+
     /**
      * @brief Деструктор.
      *
@@ -229,7 +271,7 @@ public:
     ~DynamicArray() {
         if (arr != nullptr) {
             for (size_t i = 0; i < sz; ++i) AllocatorTraits::destroy(alloc, arr + i);
-            AllocatorTraits::deallocate(alloc, arr, cap);
+            deallocate_storage(arr, cap);
         }
     }
 
@@ -242,25 +284,35 @@ public:
      */
     DynamicArray(const DynamicArray& d_arr)
     requires std::copy_constructible<T>
-        : arr(nullptr), sz(0), cap(0), alloc(std::allocator_traits<Allocator>::select_on_container_copy_construction(d_arr.alloc))
+        : DynamicArray(d_arr, AllocatorTraits::select_on_container_copy_construction(d_arr.alloc)) {}
+
+    /**
+     * @brief Конструктор копирования с заданным аллокатором
+     * @param d_arr Другой DynamicArray
+     * @param alloc Аллокатор для управления памятью
+     *
+     * @exception std::bad_alloc При невозможности выделить память
+     * @exception Любые исключения от конструктора копирования T
+     */
+    DynamicArray(const DynamicArray& d_arr, const Allocator& alloc)
+    requires std::copy_constructible<T>
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(alloc)
     {
         reserve(d_arr.cap);
-        sz = d_arr.sz;
-
-        size_t i;
-        try{
-            for(i = 0; i < sz; ++i) AllocatorTraits::construct(alloc, arr + i, d_arr.arr[i]);
-        }
-        catch(const std::exception&) {
-            for(size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, arr + j);
-            AllocatorTraits::deallocate(alloc, arr, cap);
+        try {
+            detail::construct_n_from(this->alloc, d_arr.arr, d_arr.sz, arr);
+        } catch (...) {
+            deallocate_storage(arr, cap);
             throw;
         }
+        sz = d_arr.sz;
     }
 
     /**
      * @brief Оператор присваивания копированием.
      *
+     * Аллокатор d_arr перенимается, только если propagate_on_container_copy_assignment.
+     *
      * @param d_arr Другой DynamicArray
      * @return DynamicArray& Ссылка на этот массив
      *
@@ -271,8 +323,11 @@ public:
     requires std::copyable<T>
     {
         if (this != &d_arr) {
-            DynamicArray temp(d_arr);
-            *this = std::move(temp);
+            constexpr bool propagate = AllocatorTraits::propagate_on_container_copy_assignment::value;
+            DynamicArray temp(d_arr, propagate ? d_arr.alloc : alloc);
+            release_storage();
+            if constexpr (propagate) alloc = temp.alloc;
+            take_storage(temp);
         }
         return *this;
     }
@@ -284,50 +339,230 @@ public:
      *
      * @exception Не бросает исключений
      */
-    DynamicArray(DynamicArray&& d_arr) noexcept
-        : arr(d_arr.arr), sz(d_arr.sz), cap(d_arr.cap), alloc(std::move(d_arr.alloc))
+    DynamicArray(DynamicArray&& d_arr) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(std::move(d_arr.alloc))
     {
-        d_arr.sz = 0;
-        d_arr.cap = 0;
-        d_arr.arr = nullptr;
-        d_arr.alloc = Allocator();
+        take_storage(d_arr);
+    }
+
+    /**
+     * @brief Конструктор перемещения с заданным аллокатором
+     *
+     * Если alloc не равен аллокатору d_arr, буфер забрать нельзя, и элементы перемещаются поштучно.
+     *
+     * @param d_arr Другой DynamicArray
+     * @param alloc Аллокатор для управления памятью
+     *
+     * @exception std::bad_alloc При невозможности выделить память
+     * @exception Любые исключения от конструктора перемещения T
+     */
+    DynamicArray(DynamicArray&& d_arr, const Allocator& alloc)
+        : arr(inline_data()), sz(0), cap(InlineCapacity), alloc(alloc)
+    {
+        if (AllocatorTraits::is_always_equal::value || this->alloc == d_arr.alloc) {
+            take_storage(d_arr);
+        } else {
+            reserve(d_arr.sz);
+            try {
+                detail::move_construct_n(this->alloc, d_arr.arr, d_arr.sz, arr);
+            } catch (...) {
+                deallocate_storage(arr, cap);
+                throw;
+            }
+            sz = d_arr.sz;
+            d_arr.clear();
+        }
     }
 
     /**
      * @brief Оператор присваивания перемещением.
      *
+     * Аллокатор d_arr перенимается, только если propagate_on_container_move_assignment.
+     * Если аллокатор не распространяется и не равен нашему, буфер d_arr забрать нельзя:
+     * элементы перемещаются поштучно в нашу память.
+     *
      * @param d_arr Другой DynamicArray
      * @return DynamicArray& Ссылка на этот массив
      *
-     * @exception Не бросает исключений
+     * @exception Не бросает исключений, если аллокатор распространяется или всегда равен
      */
-    DynamicArray& operator = (DynamicArray&& d_arr) noexcept
+    DynamicArray& operator = (DynamicArray&& d_arr)
+    noexcept((InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) &&
+             (AllocatorTraits::propagate_on_container_move_assignment::value ||
+              AllocatorTraits::is_always_equal::value))
     {
-        if (this != &d_arr) {
-            if(arr != nullptr){                                                                  //
-                for(size_t i = 0; i < sz; ++i) AllocatorTraits::destroy(alloc, arr + i);         // old array destruction
-                AllocatorTraits::deallocate(alloc, arr, cap);                                    //
-                arr = nullptr;                                                                   //
-            }                                                                                    //
+        if (this == &d_arr) return *this;
 
-            sz = d_arr.sz;
-            cap = d_arr.cap;
-            arr = d_arr.arr;
-            alloc = std::move(d_arr.alloc);
+        constexpr bool propagate = AllocatorTraits::propagate_on_container_move_assignment::value;
 
-            d_arr.sz = 0;
-            d_arr.cap = 0;
-            d_arr.arr = nullptr;
-            d_arr.alloc = Allocator();
+        if constexpr (!propagate && !AllocatorTraits::is_always_equal::value) {
+            if (alloc != d_arr.alloc) {
+                assign(std::make_move_iterator(d_arr.begin()), std::make_move_iterator(d_arr.end()));
+                d_arr.clear();
+                return *this;
+            }
         }
+
+        release_storage();
+        if constexpr (propagate) alloc = std::move(d_arr.alloc);
+        take_storage(d_arr);
         return *this;
     }
 
+    //STORAGE BLOCK
+
+private:
+
+    // Для std::allocator и тривиально переносимых T буфер выделяется через malloc,
+    // чтобы при росте можно было звать realloc: он расширяет блок на месте, если за ним
+    // есть свободная память, а для больших (mmap) блоков glibc делает mremap без копирования.
+    static constexpr bool uses_realloc =
+        std::is_same_v<Allocator, std::allocator<T>> &&
+        is_trivially_relocatable_v<T> &&
+        alignof(T) <= alignof(std::max_align_t);
+
+    /**
+     * @brief Указатель на встроенный буфер (nullptr, если InlineCapacity == 0).
+     *
+     * @exception Не бросает исключений
+     */
+    T* inline_data() noexcept {
+        if constexpr (InlineCapacity == 0) return nullptr;
+        else return reinterpret_cast<T*>(inline_buf.bytes);
+    }
+    const T* inline_data() const noexcept {
+        if constexpr (InlineCapacity == 0) return nullptr;
+        else return reinterpret_cast<const T*>(inline_buf.bytes);
+    }
+
+    /**
+     * @brief Лежат ли элементы во встроенном буфере.
+     *
+     * @exception Не бросает исключений
+     */
+    bool is_inline() const noexcept {
+        if constexpr (InlineCapacity == 0) return false;
+        else return arr == inline_data();
+    }
+
+    /**
+     * @brief Выделяет неинициализированный буфер под n элементов.
+     *
+     * @param n Количество элементов
+     * @return T* Указатель на буфер (nullptr при n == 0 в режиме realloc)
+     *
+     * @exception std::bad_alloc При невозможности выделить память
+     */
+    T* allocate_storage(size_t n) {
+        if constexpr (uses_realloc) {
+            if (n == 0) return nullptr;
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+            void* p = std::malloc(n * sizeof(T));
+            if (p == nullptr) throw std::bad_alloc();
+            return static_cast<T*>(p);
+        } else {
+            return AllocatorTraits::allocate(alloc, n);
+        }
+    }
+
+    /**
+     * @brief Освобождает буфер, выделенный allocate_storage(). Встроенный буфер и nullptr игнорируются.
+     *
+     * @param p Указатель на буфер
+     * @param n Ёмкость буфера
+     *
+     * @exception Не бросает исключений
+     */
+    void deallocate_storage(T* p, size_t n) noexcept {
+        // Пустой массив буфера не имеет, а nullptr не обязан приниматься аллокатором
+        if (p == nullptr) return;
+        if constexpr (InlineCapacity > 0) {
+            if (p == inline_data()) return;
+        }
+        if constexpr (uses_realloc) std::free(p);
+        else AllocatorTraits::deallocate(alloc, p, n);
+    }
+
+    /**
+     * @brief Меняет ёмкость буфера через realloc (только в режиме uses_realloc и вне встроенного буфера).
+     *
+     * @param n Новая ёмкость, n > 0
+     *
+     * @exception std::bad_alloc При невозможности выделить память. Массив при этом не изменяется
+     */
+    void reallocate_storage(size_t n)
+    requires uses_realloc
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        void* p = std::realloc(static_cast<void*>(arr), n * sizeof(T));
+        if (p == nullptr) throw std::bad_alloc();
+        arr = static_cast<T*>(p);
+        cap = n;
+    }
+
+    /**
+     * @brief Ёмкость, до которой нужно вырасти, чтобы вместить required элементов.
+     *
+     * @param required Необходимая ёмкость (> cap)
+     * @return size_t Новая ёмкость по GrowthPolicy (>= required)
+     *
+     * @exception Не бросает исключений
+     */
+    size_t grow_capacity(size_t required) const noexcept {
+        return GrowthPolicy::template next_capacity<T>(cap, required);
+    }
+
+    /**
+     * @brief Уничтожает элементы и освобождает буфер. Массив становится пустым.
+     *
+     * @exception Не бросает исключений
+     */
+    void release_storage() noexcept {
+        if (arr != nullptr) {
+            for (size_t i = 0; i < sz; ++i) AllocatorTraits::destroy(alloc, arr + i);
+            deallocate_storage(arr, cap);
+        }
+        arr = inline_data();
+        sz = 0;
+        cap = InlineCapacity;
+    }
+
+    /**
+     * @brief Забирает содержимое d_arr, который становится пустым.
+     *
+     * Массив должен быть пуст и без выделенного буфера, а аллокаторы - равны.
+     * Внешний буфер d_arr забирается целиком, встроенный переносится поштучно.
+     *
+     * @param d_arr Другой DynamicArray
+     *
+     * @exception Не бросает исключений, если InlineCapacity == 0
+     */
+    void take_storage(DynamicArray& d_arr) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
+        if (d_arr.is_inline()) {
+            // Встроенный буфер нельзя забрать, элементы переносятся поштучно
+            uninitialized_relocate_n(alloc, d_arr.arr, d_arr.sz, arr);
+        } else {
+            arr = d_arr.arr;
+            cap = d_arr.cap;
+        }
+        sz = d_arr.sz;
+
+        d_arr.sz = 0;
+        d_arr.cap = InlineCapacity;
+        d_arr.arr = d_arr.inline_data();
+    }
+
+public:
+
     //RESERVE and SHRINK_TO_FIT BLOCK
 
     /**
      * @brief Увеличивает ёмкость массива до указанного размера.
      *
+     * Для тривиально переносимых T (см. mystl::is_trivially_relocatable) элементы
+     * переносятся в новый буфер одним memcpy, без поэлементного перемещения и разрушения.
+     * Если вдобавок используется std::allocator, буфер по возможности расширяется на месте.
+     *
      * @param n Новая минимальная ёмкость
      *
      * @exception std::bad_alloc При невозможности выделить память
@@ -336,26 +571,30 @@ public:
     void reserve(size_t n) {
         if (n <= cap) return;
 
-        T* newarr = AllocatorTraits::allocate(alloc, n);
+        if constexpr (uses_realloc) {
+            if (!is_inline()) {
+                reallocate_storage(n);
+                return;
+            }
+        }
+
+        T* newarr = allocate_storage(n);
 
-        size_t i = 0;
         try{
-            for (; i < sz; ++i) AllocatorTraits::construct(alloc, newarr + i, std::move_if_noexcept(arr[i]));
+            uninitialized_relocate_n(alloc, arr, sz, newarr);
         }
-        catch(const std::exception&) {
-            for (size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, newarr + j);
-            AllocatorTraits::deallocate(alloc, newarr, n);
+        catch(...) {
+            deallocate_storage(newarr, n);
             throw;
         }
 
-        for(size_t k = 0; k < sz; ++k) AllocatorTraits::destroy(alloc, arr + k);
-        AllocatorTraits::deallocate(alloc, arr, cap);
+        deallocate_storage(arr, cap);
 
         arr = newarr;
         cap = n;
     }
     /**
-    * @brief Уменьшает ёмкость массива до размера.
+    * @brief Уменьшает ёмкость массива до размера (или до InlineCapacity, если элементы туда помещаются).
     *
     * @exception std::bad_alloc При невозможности выделить память
     * @exception Любые исключения от конструкторов перемещения/копирования T
@@ -363,19 +602,40 @@ public:
     void shrink_to_fit() {
         if (sz == cap) return;
 
-        T* newarr = AllocatorTraits::allocate(alloc, sz);
+        if constexpr (InlineCapacity > 0) {
+            if (is_inline()) return;
+            if (sz <= InlineCapacity) {
+                // Возвращаемся во встроенный буфер
+                uninitialized_relocate_n(alloc, arr, sz, inline_data());
+                deallocate_storage(arr, cap);
+                arr = inline_data();
+                cap = InlineCapacity;
+                return;
+            }
+        }
+
+        if constexpr (uses_realloc) {
+            if (sz == 0) {
+                deallocate_storage(arr, cap);
+                arr = nullptr;
+                cap = 0;
+            } else {
+                reallocate_storage(sz);
+            }
+            return;
+        }
+
+        T* newarr = allocate_storage(sz);
 
-        size_t i = 0;
         try{
-            for (; i < sz; ++i) AllocatorTraits::construct(alloc, newarr + i, std::move_if_noexcept(arr[i]));
+            uninitialized_relocate_n(alloc, arr, sz, newarr);
         }
-        catch(const std::exception&) {
-            for (size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, newarr + j);
-            AllocatorTraits::deallocate(alloc, newarr, sz);
+        catch(...) {
+            deallocate_storage(newarr, sz);
             throw;
         }
-        for(size_t g = 0; g < sz; ++g) AllocatorTraits::destroy(alloc, arr + g);
-        AllocatorTraits::deallocate(alloc, arr, cap);
+
+        deallocate_storage(arr, cap);
 
         arr = newarr;
         cap = sz;
@@ -395,7 +655,11 @@ public:
     template <typename... Args>
     requires std::constructible_from<T, Args...>
     void emplace_back(Args&&... args) {
-        if (cap == sz) reserve(sz > 0 ? 2 * sz : 1);
+        if (cap == sz) {
+            // args могут ссылаться на элемент массива, а рост освобождает старый буфер
+            emplace(const_iterator(arr + sz), std::forward<Args>(args)...);
+            return;
+        }
         AllocatorTraits::construct(alloc, arr + sz, std::forward<Args>(args)...);
         ++sz;
     }
@@ -439,22 +703,9 @@ private:
      * @param end Указатель на конец удаляемого диапазона
      * @return T* Указатель на позицию после удаления
      *
-     * @exception Может бросать исключения от оператора копирования T
+     * @exception Может бросать исключения от оператора перемещения T
      */
-    T* do_erase(T* beg, T* end) {
-        size_t diff = end - beg;
-
-        if (diff == 0) return end;
-
-        for (T* p = beg; p + diff < arr + sz; ++p)
-            *p = std::move_if_noexcept(*(p + diff));
-
-        for (size_t i = 0; i < diff; ++i)
-            AllocatorTraits::destroy(alloc, arr + sz - 1 - i);
-
-        sz -= diff;
-        return beg;
-    }
+    T* do_erase(T* beg, T* end) { return detail::erase_range(alloc, arr, sz, beg, end); }
 
 public:
 
@@ -503,7 +754,7 @@ public:
             try{
                 for (; i < count; ++i) AllocatorTraits::construct(alloc, arr + i, value);
             }catch(const std::exception&){
-                for (size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, arr + j);
+                for (size_t j = sz; j < i; ++j) AllocatorTraits::destroy(alloc, arr + j);
                 throw;
             }
             sz = count;
@@ -539,6 +790,56 @@ public:
         }
     }
 
+    /**
+     * @brief Изменяет размер массива, инициализируя новые элементы по умолчанию.
+     *
+     * Для тривиальных типов новые элементы остаются неинициализированными
+     * и должны быть перезаписаны до чтения.
+     *
+     * @param count Новый размер массива
+     *
+     * @exception std::bad_alloc При необходимости увеличения capacity
+     * @exception Любые исключения от дефолтного конструктора T
+     */
+    void resize_for_overwrite(size_t count)
+    requires std::default_initializable<T>
+    {
+        if (count <= sz) {
+            for (size_t i = count; i < sz; ++i) AllocatorTraits::destroy(alloc, arr + i);
+            sz = count;
+            return;
+        }
+        if (count > cap) reserve(count);
+        detail::default_construct_n(alloc, arr + sz, count - sz);
+        sz = count;
+    }
+
+    /**
+     * @brief Увеличивает массив до count элементов и отдает их на заполнение операции op.
+     *
+     * Новые элементы инициализируются по умолчанию (для тривиальных типов - не трогаются),
+     * затем вызывается op(data(), count). Операция возвращает итоговый размер r <= count,
+     * элементы [r, size()) уничтожаются.
+     *
+     * @param count Размер буфера, доступного операции
+     * @param op Операция вида size_t(T* data, size_t count)
+     *
+     * @exception std::bad_alloc При необходимости увеличения capacity
+     * @exception Любые исключения от дефолтного конструктора T или от op
+     */
+    template<typename Operation>
+    requires std::default_initializable<T> &&
+             std::convertible_to<std::invoke_result_t<Operation&, T*, size_t>, size_t>
+    void resize_and_overwrite(size_t count, Operation op) {
+        if (count > sz) resize_for_overwrite(count);
+
+        size_t r = static_cast<size_t>(op(arr, count));
+        if (r > count) r = count;
+
+        for (size_t i = r; i < sz; ++i) AllocatorTraits::destroy(alloc, arr + i);
+        sz = r;
+    }
+
     /**
     * @brief Удаляет последний элемент массива.
     *
@@ -566,22 +867,18 @@ public:
     template<typename... Args>
     requires std::constructible_from<T, Args...>
     iterator emplace(const_iterator pos, Args&&... args) {
-        size_t insertion_id = pos - begin();
+        size_t insertion_id = pos.base() - arr;
 
-        if (cap == sz) reserve(sz > 0 ? 2 * sz : 1);
-        ++sz;
-
-        try{
-            for (size_t i = sz - 1; i > insertion_id; --i) arr[i] = std::move_if_noexcept(arr[i - 1]);
-
-            AllocatorTraits::construct(alloc, arr + insertion_id, std::forward<Args>(args)...);
+        if (cap != sz && insertion_id == sz) {
+            AllocatorTraits::construct(alloc, arr + sz, std::forward<Args>(args)...);
+            ++sz;
+            return iterator(arr + insertion_id);
         }
-        catch(...) {
-            for (size_t i = sz - 1; i > insertion_id; --i) arr[i] = std::move_if_noexcept(arr[i - 1]);
-            --sz;
-            throw;
-        }
-        return iterator(arr + insertion_id);
+
+        // args могут ссылаться на элементы массива, которые затрет сдвиг хвоста
+        // или перевыделение памяти, поэтому значение сначала собирается отдельно
+        detail::temporary_value<T, Allocator> tmp(alloc, std::forward<Args>(args)...);
+        return iterator(insert_range_n(insertion_id, std::make_move_iterator(&tmp.get()), 1));
     }
 
     /**
@@ -610,6 +907,200 @@ public:
     iterator insert(const_iterator pos, T&& value)
     requires std::movable<T> { return emplace(pos, std::move(value)); }
 
+private:
+
+    /**
+     * @brief Переносит элементы в новый буфер, оставляя дыру [idx, idx + n) под вставку.
+     *
+     * @param newarr Новый буфер ёмкостью не меньше sz + n
+     * @param idx Позиция дыры
+     * @param n Размер дыры
+     *
+     * @exception Любые исключения от конструкторов перемещения/копирования T.
+     *            В этом случае старый буфер не изменяется, а newarr остается неинициализированным
+     */
+    void relocate_around(T* newarr, size_t idx, size_t n) {
+        if constexpr (allocator_relocates_bitwise_v<T, Allocator>) {
+            uninitialized_relocate_n(alloc, arr, idx, newarr);
+            uninitialized_relocate_n(alloc, arr + idx, sz - idx, newarr + idx + n);
+        } else {
+            size_t i = 0;
+            try {
+                for (; i < sz; ++i)
+                    AllocatorTraits::construct(alloc, newarr + (i < idx ? i : i + n), std::move_if_noexcept(arr[i]));
+            } catch (...) {
+                for (size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, newarr + (j < idx ? j : j + n));
+                throw;
+            }
+            for (size_t k = 0; k < sz; ++k) AllocatorTraits::destroy(alloc, arr + k);
+        }
+    }
+
+    /**
+     * @brief Вставляет n элементов из диапазона first в позицию idx.
+     *
+     * Итоговый размер известен заранее, поэтому перевыделение происходит не более одного раза,
+     * а хвост массива сдвигается ровно один раз.
+     *
+     * @param idx Позиция вставки
+     * @param first Итератор на начало вставляемого диапазона (не должен указывать внутрь массива)
+     * @param n Количество вставляемых элементов
+     * @return T* Указатель на первый вставленный элемент
+     *
+     * @exception std::bad_alloc При невозможности выделить память
+     * @exception Любые исключения от конструктора T или перемещения элементов
+     */
+    template<typename ForwardIt>
+    T* insert_range_n(size_t idx, ForwardIt first, size_t n) {
+        if (n == 0) return arr + idx;
+
+        if (sz + n > cap) {
+            if constexpr (uses_realloc) {
+                reserve(grow_capacity(sz + n));
+            } else {
+                // Новые элементы сразу строятся на своих местах в новом буфере,
+                // старые переносятся вокруг них
+                size_t new_cap = grow_capacity(sz + n);
+                T* newarr = allocate_storage(new_cap);
+
+                try {
+                    detail::construct_n_from(alloc, first, n, newarr + idx);
+                } catch (...) {
+                    deallocate_storage(newarr, new_cap);
+                    throw;
+                }
+
+                try {
+                    relocate_around(newarr, idx, n);
+                } catch (...) {
+                    for (size_t j = 0; j < n; ++j) AllocatorTraits::destroy(alloc, newarr + idx + j);
+                    deallocate_storage(newarr, new_cap);
+                    throw;
+                }
+
+                deallocate_storage(arr, cap);
+                arr = newarr;
+                cap = new_cap;
+                sz += n;
+                return arr + idx;
+            }
+        }
+
+        return detail::insert_n_in_place(alloc, arr, sz, idx, first, n);
+    }
+
+public:
+
+    /**
+     * @brief Вставляет n копий значения в указанную позицию.
+     *
+     * @param pos Итератор указывающий на позицию для вставки
+     * @param n Количество копий
+     * @param value Значение для копирования
+     * @return iterator Итератор на первый вставленный элемент
+     *
+     * @exception std::bad_alloc При необходимости увеличения capacity
+     * @exception Любые исключения от конструктора копирования T
+     */
+    iterator insert(const_iterator pos, size_t n, const T& value)
+    requires std::copy_constructible<T>
+    {
+        // value может указывать внутрь массива, а сдвиг хвоста его затрет
+        const T copy(value);
+        return iterator(insert_range_n(pos.base() - arr, detail::fill_iterator<T>(&copy, 0), n));
+    }
+
+    /**
+     * @brief Вставляет диапазон [first, last) в указанную позицию.
+     *
+     * @param pos Итератор указывающий на позицию для вставки
+     * @param first Итератор на начало диапазона (не должен указывать внутрь массива)
+     * @param last Итератор на конец диапазона
+     * @return iterator Итератор на первый вставленный элемент
+     *
+     * @exception std::bad_alloc При необходимости увеличения capacity
+     * @exception Любые исключения от конструктора T или перемещения элементов
+     */
+    template<std::input_iterator InputIt>
+    requires std::constructible_from<T, std::iter_reference_t<InputIt>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        size_t idx = pos.base() - arr;
+        if constexpr (std::forward_iterator<InputIt>) {
+            return iterator(insert_range_n(idx, first, static_cast<size_t>(std::distance(first, last))));
+        } else {
+            // Однопроходный диапазон: сначала собираем его, чтобы узнать размер
+            DynamicArray buffer(first, last, alloc);
+            return iterator(insert_range_n(idx, std::make_move_iterator(buffer.arr), buffer.sz));
+        }
+    }
+
+    //ASSIGN AND APPEND BLOCK
+
+    /**
+     * @brief Добавляет элементы диапазона в конец массива.
+     *
+     * @param rg Диапазон элементов
+     *
+     * @exception std::bad_alloc При необходимости увеличения capacity
+     * @exception Любые исключения от конструктора T
+     */
+    template<std::ranges::input_range R>
+    requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+    void append_range(R&& rg) {
+        if constexpr (std::ranges::forward_range<R>) {
+            insert_range_n(sz, std::ranges::begin(rg), static_cast<size_t>(std::ranges::distance(rg)));
+        } else {
+            // Однопроходный диапазон читаем один раз (его итератор может быть только перемещаемым),
+            // но если размер известен заранее - память под все элементы выделяем сразу
+            if constexpr (std::ranges::sized_range<R>) reserve(sz + static_cast<size_t>(std::ranges::size(rg)));
+            for (auto&& value : rg) emplace_back(std::forward<decltype(value)>(value));
+        }
+    }
+
+    /**
+     * @brief Заменяет содержимое массива элементами диапазона [first, last).
+     *
+     * @param first Итератор на начало диапазона (не должен указывать внутрь массива)
+     * @param last Итератор на конец диапазона
+     *
+     * @exception std::bad_alloc При невозможности выделить память
+     * @exception Любые исключения от конструктора или оператора присваивания T
+     */
+    template<std::input_iterator InputIt>
+    requires std::constructible_from<T, std::iter_reference_t<InputIt>>
+    void assign(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            size_t n = static_cast<size_t>(std::distance(first, last));
+
+            if (n > cap) {
+                T* newarr = allocate_storage(n);
+                try {
+                    detail::construct_n_from(alloc, first, n, newarr);
+                } catch (...) {
+                    deallocate_storage(newarr, n);
+                    throw;
+                }
+                clear();
+                deallocate_storage(arr, cap);
+                arr = newarr;
+                cap = n;
+                sz = n;
+            } else if (n <= sz) {
+                detail::assign_n_from<T, Allocator>(first, n, arr);
+                for (size_t i = n; i < sz; ++i) AllocatorTraits::destroy(alloc, arr + i);
+                sz = n;
+            } else {
+                InputIt mid = std::next(first, sz);
+                detail::assign_n_from<T, Allocator>(first, sz, arr);
+                detail::construct_n_from(alloc, mid, n - sz, arr + sz);
+                sz = n;
+            }
+        } else {
+            clear();
+            for (; first != last; ++first) emplace_back(*first);
+        }
+    }
+
     //ETC BLOCK
     /**
      * @brief Возвращает размер массива.
@@ -638,6 +1129,15 @@ public:
      */
     [[nodiscard]] bool empty() const noexcept { return sz == 0; }
 
+    /**
+     * @brief Возвращает копию аллокатора.
+     *
+     * @return Allocator Аллокатор массива
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] Allocator get_allocator() const noexcept { return alloc; }
+
     /**
      * @brief Доступ к элементу по индексу без проверки границ.
      *
@@ -712,18 +1212,42 @@ public:
     /**
     * @brief Обменивает содержимое двух массивов.
     *
+    * Аллокаторы обмениваются, только если propagate_on_container_swap;
+    * иначе они должны быть равны.
+    *
     * @param other Массив для обмена
     *
     * @exception Не бросает исключений
     */
-    void swap(DynamicArray& other) noexcept{
+    void swap(DynamicArray& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
         if(this == &other) return;
+        if constexpr (InlineCapacity > 0) {
+            if (is_inline() || other.is_inline()) {
+                DynamicArray temp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(temp);
+                return;
+            }
+        }
         std::swap(arr, other.arr);
         std::swap(sz, other.sz);
         std::swap(cap, other.cap);
+        if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc, other.alloc);
+        }
     }
 };
 
+/**
+ * @brief SmallDynamicArray - DynamicArray, хранящий до N элементов прямо в объекте
+ *
+ * Короткие массивы не обращаются к аллокатору и лежат рядом с владельцем;
+ * при превышении N элементы переезжают в кучу. Интерфейс совпадает с DynamicArray.
+ */
+template<typename T, size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DefaultGrowth>
+using SmallDynamicArray = DynamicArray<T, Allocator, GrowthPolicy, N>;
+
 } // namespace mystl
 
 #endif // DYNAMICARRAY_HPP
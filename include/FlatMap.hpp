@@ -0,0 +1,779 @@
+#ifndef FLATMAP_HPP
+#define FLATMAP_HPP
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "DynamicArray.hpp"
+#include "MapTraits.hpp"
+
+// CURRENT VERSION v0.1.1
+
+// CHANGELOG:
+// > replace() переносит массивы на аллокаторы таблицы до обмена: при неравных аллокаторах
+//   исключение больше не оставляет ключи и значения разной длины
+
+// Отсортированный массив с интерфейсом поиска Map. Ключи и значения лежат в двух DynamicArray
+// (структура массивов): бинарный поиск читает только плотный массив ключей, а значения
+// затрагиваются один раз, для найденного элемента. Рассчитан на таблицы, которые собираются
+// целиком (replace() или конструктор от диапазона) и затем много раз читаются:
+// вставка и удаление одного элемента стоят O(n).
+//
+//     template<typename K, typename V> using Table = mystl::FlatMap<K, V>;   // вместо mystl::Map<K, V>
+//
+// Отличия от Map:
+// > Итераторы произвольного доступа, разыменование дает std::pair<const Key&, T&> (прокси, а не ссылку).
+//   const_iterator проходит проверку std::random_access_iterator только с C++23, где у std::pair
+//   появился common_reference для пар ссылок
+// > Любая вставка и удаление делают невалидными все итераторы
+
+namespace mystl {
+
+//   ~~Интерфейс политики поиска~~
+//
+//   struct MySearch {
+//       template<typename T, typename Pred>
+//       static constexpr std::size_t partition_point(const T* first, std::size_t n, Pred pred);
+//   };
+//
+//   first[0..n) разбит предикатом: сначала все элементы с pred == true, затем все с pred == false.
+//   Результат - число элементов с pred == true.
+
+/**
+ * @brief search_policy - концепт политики поиска по отсортированному массиву T
+ */
+template<typename Policy, typename T>
+concept search_policy = requires(const T* first, std::size_t n, bool (*pred)(const T&)) {
+    { Policy::partition_point(first, n, pred) } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * @brief BinarySearch - классический бинарный поиск
+ *
+ * Ветвление на каждом шаге предсказывается плохо, зато поиск может закончиться,
+ * не дочитав до конца (выгодно при дорогих сравнениях, например длинных строк).
+ */
+struct BinarySearch {
+    template<typename T, typename Pred>
+    static constexpr std::size_t partition_point(const T* first, std::size_t n, Pred pred) {
+        std::size_t lo = 0, hi = n;
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (pred(first[mid])) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+};
+
+/**
+ * @brief BranchlessSearch - бинарный поиск без ветвлений (политика по умолчанию)
+ *
+ * Число шагов зависит только от n, а выбор половины компилируется в cmov,
+ * поэтому нет промахов предсказателя переходов. Для дешевых сравнений (числа, указатели)
+ * на больших таблицах быстрее BinarySearch в 1.5-2 раза.
+ */
+struct BranchlessSearch {
+    template<typename T, typename Pred>
+    static constexpr std::size_t partition_point(const T* first, std::size_t n, Pred pred) {
+        if (n == 0) return 0;
+
+        const T* base = first;
+        while (n > 1) {
+            std::size_t half = n / 2;
+            base = pred(base[half]) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<std::size_t>(base - first) + (pred(*base) ? 1 : 0);
+    }
+};
+
+template<
+    typename Key,
+    typename T,
+    typename Compare = std::less<Key>,
+    typename Allocator = std::allocator<std::pair<const Key, T>>,
+    typename SearchPolicy = BranchlessSearch
+    >
+requires search_policy<SearchPolicy, Key>
+class FlatMap {
+public:
+
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+
+private:
+
+    using key_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+    using mapped_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+public:
+
+    using key_container = DynamicArray<Key, key_allocator>;
+    using mapped_container = DynamicArray<T, mapped_allocator>;
+
+private:
+
+    key_container keys_;
+    mapped_container values_;
+
+    Compare comp_;
+
+    //ITERATOR BLOCK
+
+    template <bool IsConst>
+    class common_iterator {
+    private:
+
+        using ConditionalMappedPtr = std::conditional_t<IsConst, const T*, T*>;
+        using ConditionalMappedRef = std::conditional_t<IsConst, const T&, T&>;
+
+        friend class FlatMap;
+
+        const Key* key_ = nullptr;
+        ConditionalMappedPtr value_ = nullptr;
+
+    public:
+
+        using value_type        = typename FlatMap::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::pair<const Key&, ConditionalMappedRef>;
+        using iterator_concept  = std::random_access_iterator_tag;
+        // Разыменование возвращает прокси, поэтому по классификации C++17 это только input-итератор
+        using iterator_category = std::input_iterator_tag;
+
+        /**
+         * @brief pointer - результат operator ->: хранит прокси-пару, чтобы it->first и it->second работали
+         */
+        struct pointer {
+            reference ref_;
+            reference* operator -> () noexcept { return &ref_; }
+        };
+
+        common_iterator() = default;
+
+        common_iterator(const Key* key, ConditionalMappedPtr value) noexcept : key_(key), value_(value) {}
+
+        /**
+         * @brief Конструктор const_iterator из iterator
+         */
+        template<bool OtherConst>
+        requires (IsConst && !OtherConst)
+        common_iterator(const common_iterator<OtherConst>& other) noexcept : key_(other.key_), value_(other.value_) {}
+
+        reference operator * () const noexcept { return reference(*key_, *value_); }
+
+        pointer operator -> () const noexcept { return pointer{ **this }; }
+
+        reference operator [] (difference_type n) const noexcept { return reference(key_[n], value_[n]); }
+
+        template <bool OtherConst>
+        bool operator == (const common_iterator<OtherConst>& other) const noexcept { return key_ == other.key_; }
+
+        template <bool OtherConst>
+        std::strong_ordering operator <=> (const common_iterator<OtherConst>& other) const noexcept
+        { return std::compare_three_way()(key_, other.key_); }
+
+        common_iterator& operator ++ () noexcept { ++key_; ++value_; return *this; }
+        common_iterator operator ++ (int) noexcept { auto copy = *this; ++(*this); return copy; }
+
+        common_iterator& operator -- () noexcept { --key_; --value_; return *this; }
+        common_iterator operator -- (int) noexcept { auto copy = *this; --(*this); return copy; }
+
+        common_iterator& operator += (difference_type n) noexcept { key_ += n; value_ += n; return *this; }
+        common_iterator& operator -= (difference_type n) noexcept { key_ -= n; value_ -= n; return *this; }
+
+        common_iterator operator + (difference_type n) const noexcept { auto copy = *this; return copy += n; }
+        common_iterator operator - (difference_type n) const noexcept { auto copy = *this; return copy -= n; }
+
+        friend common_iterator operator + (difference_type n, const common_iterator& it) noexcept { return it + n; }
+
+        template <bool OtherConst>
+        difference_type operator - (const common_iterator<OtherConst>& other) const noexcept { return key_ - other.key_; }
+    };
+
+public:
+
+    //ORDINARY ITERATOR BLOCK
+
+    using iterator = common_iterator<false>;
+
+    using const_iterator = common_iterator<true>;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    iterator begin() noexcept { return iterator(keys_.data(), values_.data()); }
+    const_iterator begin() const noexcept { return const_iterator(keys_.data(), values_.data()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return begin() + size(); }
+    const_iterator end() const noexcept { return begin() + size(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+    //BASIC FUNCTIONAL BLOCK
+
+    /**
+     * @brief Дефолт конструктор
+     */
+    FlatMap() : FlatMap(Compare(), Allocator()) {}
+
+    /**
+     * @brief Конструктор из компаратора и аллокатора
+     *
+     * @param comp - компаратор
+     * @param alloc - аллокатор (перепривязывается к Key и T)
+     */
+    explicit FlatMap(const Compare& comp, const Allocator& alloc = Allocator()) :
+        keys_(key_allocator(alloc)),
+        values_(mapped_allocator(alloc)),
+        comp_(comp) {}
+
+    /**
+     * @brief FlatMap - конструктор от аллокатора
+     */
+    explicit FlatMap(const Allocator& alloc) : FlatMap(Compare(), alloc) {}
+
+    /**
+     * @brief FlatMap - конструктор от диапазона
+     *
+     * Элементы складываются в массивы как есть, затем сортируются одним проходом.
+     * Из равных ключей остается первый (как при поэлементной вставке в Map).
+     *
+     * @param first - итератор на начало диапазона
+     * @param last - итератор на конец диапазона
+     * @param comp - компаратор
+     * @param alloc - аллокатор
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструкторов Key, T и компаратора
+     */
+    template<std::input_iterator InputIt>
+    requires std::constructible_from<value_type, std::iter_reference_t<InputIt>>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator()) :
+        FlatMap(comp, alloc)
+    {
+        if constexpr (std::forward_iterator<InputIt>) {
+            std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            keys_.reserve(n);
+            values_.reserve(n);
+        }
+        for (; first != last; ++first) {
+            value_type kv(*first);
+            keys_.push_back(std::move(kv.first));
+            try {
+                values_.push_back(std::move(kv.second));
+            } catch (...) {
+                keys_.pop_back();
+                throw;
+            }
+        }
+        sort_and_unique();
+    }
+
+    /**
+     * @brief FlatMap - конструктор от std::initializer_list<std::pair<Key, T>>
+     */
+    FlatMap(std::initializer_list<value_type> init,
+            const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator()) : FlatMap(init.begin(), init.end(), comp, alloc) {}
+
+    /**
+     * @brief FlatMap - конструктор от готовых массивов ключей и значений
+     *
+     * @param keys - ключи, отсортированные по comp и без повторов
+     * @param values - значения, values[i] соответствует keys[i]
+     *
+     * @exception std::invalid_argument при разных размерах массивов
+     */
+    FlatMap(key_container&& keys, mapped_container&& values, const Compare& comp = Compare()) :
+        keys_(std::move(keys)),
+        values_(std::move(values)),
+        comp_(comp)
+    {
+        if (keys_.size() != values_.size()) throw std::invalid_argument("FlatMap keys and values sizes differ");
+    }
+
+    // Копирование, перемещение и присваивание - поэлементные, аллокаторы распространяются по правилам DynamicArray
+    FlatMap(const FlatMap&) = default;
+    FlatMap(FlatMap&&) = default;
+    FlatMap& operator = (const FlatMap&) = default;
+    FlatMap& operator = (FlatMap&&) = default;
+    ~FlatMap() = default;
+
+    /**
+     * @brief swap - обмен содержимым двух FlatMap
+     */
+    void swap(FlatMap& other) noexcept {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        using std::swap;
+        swap(comp_, other.comp_);
+    }
+
+    /**
+     * @brief size - количество элементов
+     */
+    std::size_t size() const noexcept { return keys_.size(); }
+
+    /**
+     * @brief empty - Пуст ли контейнер?
+     */
+    bool empty() const noexcept { return keys_.empty(); }
+
+    /**
+     * @brief get_allocator - копия аллокатора (массивы ключей и значений используют его rebind-копии)
+     */
+    allocator_type get_allocator() const noexcept { return allocator_type(keys_.get_allocator()); }
+
+    /**
+     * @brief clear - очистка контейнера (память массивов остается за ним)
+     */
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+    }
+
+    /**
+     * @brief reserve - резервирует место под n элементов в обоих массивах
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     */
+    void reserve(std::size_t n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    /**
+     * @brief keys - отсортированный массив ключей
+     */
+    const key_container& keys() const noexcept { return keys_; }
+
+    /**
+     * @brief values - массив значений (values()[i] соответствует keys()[i])
+     */
+    const mapped_container& values() const noexcept { return values_; }
+
+    // BULK BLOCK
+
+    /**
+     * @brief replace - замена всего содержимого готовыми массивами без копирования
+     *
+     * Основной способ пересборки таблицы: массивы собираются снаружи и передаются перемещением.
+     * Оба массива сначала переезжают на аллокаторы таблицы (при равных аллокаторах - без копирования
+     * элементов) и только затем обмениваются с текущими, поэтому ключи и значения не рассинхронизируются.
+     *
+     * @param keys - ключи, отсортированные по компаратору и без повторов (не проверяется)
+     * @param values - значения, values[i] соответствует keys[i]
+     *
+     * @exception std::invalid_argument при разных размерах массивов; std::bad_alloc, исключения от
+     *            перемещения Key, T при неравных аллокаторах (содержимое таблицы при этом не меняется)
+     */
+    void replace(key_container&& keys, mapped_container&& values) {
+        if (keys.size() != values.size()) throw std::invalid_argument("FlatMap keys and values sizes differ");
+        key_container new_keys(std::move(keys), keys_.get_allocator());
+        mapped_container new_values(std::move(values), values_.get_allocator());
+        keys_.swap(new_keys);
+        values_.swap(new_values);
+    }
+
+    /**
+     * @brief extract - забирает массивы ключей и значений (FlatMap остается пустым)
+     *
+     * Вместе с replace() позволяет обновить таблицу, не копируя ее.
+     */
+    std::pair<key_container, mapped_container> extract() noexcept {
+        std::pair<key_container, mapped_container> result(std::move(keys_), std::move(values_));
+        clear();
+        return result;
+    }
+
+private:
+
+    /**
+     * @brief sort_and_unique - сортирует массивы по ключам и убирает повторы (из равных остается первый)
+     *
+     * Сортируется массив номеров, затем перестановка применяется к ключам и значениям по циклам
+     * перемещающим присваиванием, без вторых копий массивов. Если ключи уже строго возрастают,
+     * все сводится к одному проходу.
+     *
+     * @exception std::bad_alloc, исключения от перемещения Key, T и компаратора
+     *            (базовая гарантия: элементы могут остаться переставленными)
+     */
+    void sort_and_unique() {
+        std::size_t n = keys_.size();
+        bool sorted = true;
+        for (std::size_t i = 1; i < n && sorted; ++i) sorted = comp_(keys_[i - 1], keys_[i]);
+        if (sorted) return;
+
+        // order[i] - откуда взять элемент для позиции i
+        DynamicArray<std::size_t> order(n, std::size_t(0));
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(),
+                         [this](std::size_t a, std::size_t b) { return comp_(keys_[a], keys_[b]); });
+
+        for (std::size_t i = 0; i < n; ++i) {
+            if (order[i] == i) continue;
+
+            Key key(std::move(keys_[i]));
+            T value(std::move(values_[i]));
+            std::size_t j = i;
+            while (order[j] != i) {
+                std::size_t from = order[j];
+                keys_[j] = std::move(keys_[from]);
+                values_[j] = std::move(values_[from]);
+                order[j] = j;
+                j = from;
+            }
+            keys_[j] = std::move(key);
+            values_[j] = std::move(value);
+            order[j] = j;
+        }
+
+        std::size_t last = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            if (!comp_(keys_[last], keys_[i])) continue;
+            if (++last != i) {
+                keys_[last] = std::move(keys_[i]);
+                values_[last] = std::move(values_[i]);
+            }
+        }
+        keys_.erase(keys_.begin() + (last + 1), keys_.end());
+        values_.erase(values_.begin() + (last + 1), values_.end());
+    }
+
+    //FINDER BLOCK
+
+    // Гетерогенный поиск для прозрачного компаратора (см. detail::transparent_key)
+    template<typename K>
+    static constexpr bool transparent_key = detail::transparent_key<K, std::tuple<Compare>, iterator, const_iterator>;
+
+    /**
+     * @brief lower_index - номер первого ключа, не меньшего key
+     */
+    template<typename K>
+    std::size_t lower_index(const K& key) const {
+        return SearchPolicy::partition_point(keys_.data(), keys_.size(),
+                                             [&](const Key& k) { return comp_(k, key); });
+    }
+
+    /**
+     * @brief upper_index - номер первого ключа, большего key
+     */
+    template<typename K>
+    std::size_t upper_index(const K& key) const {
+        return SearchPolicy::partition_point(keys_.data(), keys_.size(),
+                                             [&](const Key& k) { return !comp_(key, k); });
+    }
+
+    /**
+     * @brief finder - номер элемента с ключом key или size()
+     */
+    template<typename K>
+    std::size_t finder(const K& key) const {
+        std::size_t i = lower_index(key);
+        return i < keys_.size() && !comp_(key, keys_[i]) ? i : keys_.size();
+    }
+
+public:
+
+    /**
+     * @brief find - поиск по ключу
+     *
+     * @return iterator на элемент или end()
+     */
+    iterator find(const Key& key) { return begin() + finder(key); }
+    const_iterator find(const Key& key) const { return begin() + finder(key); }
+
+    /**
+     * @brief find - гетерогенный поиск (только для прозрачного компаратора)
+     */
+    template<typename K>
+    requires transparent_key<K>
+    iterator find(const K& key) { return begin() + finder(key); }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator find(const K& key) const { return begin() + finder(key); }
+
+    /**
+     * @brief contains - проверяет есть ли ключ в таблице
+     */
+    bool contains(const Key& key) const { return finder(key) != size(); }
+
+    template<typename K>
+    requires transparent_key<K>
+    bool contains(const K& key) const { return finder(key) != size(); }
+
+    /**
+     * @brief count - количество элементов с ключом key (0 или 1)
+     */
+    std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    /**
+     * @brief lower_bound - первый элемент с ключом не меньше key
+     */
+    iterator lower_bound(const Key& key) { return begin() + lower_index(key); }
+    const_iterator lower_bound(const Key& key) const { return begin() + lower_index(key); }
+
+    template<typename K>
+    requires transparent_key<K>
+    iterator lower_bound(const K& key) { return begin() + lower_index(key); }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator lower_bound(const K& key) const { return begin() + lower_index(key); }
+
+    /**
+     * @brief upper_bound - первый элемент с ключом больше key
+     */
+    iterator upper_bound(const Key& key) { return begin() + upper_index(key); }
+    const_iterator upper_bound(const Key& key) const { return begin() + upper_index(key); }
+
+    template<typename K>
+    requires transparent_key<K>
+    iterator upper_bound(const K& key) { return begin() + upper_index(key); }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator upper_bound(const K& key) const { return begin() + upper_index(key); }
+
+    /**
+     * @brief equal_range - диапазон элементов с ключом key (пустой или из одного элемента)
+     */
+    std::pair<iterator, iterator> equal_range(const Key& key) {
+        std::size_t i = lower_index(key);
+        std::size_t j = i < size() && !comp_(key, keys_[i]) ? i + 1 : i;
+        return { begin() + i, begin() + j };
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+        auto [lo, hi] = const_cast<FlatMap*>(this)->equal_range(key);
+        return { lo, hi };
+    }
+
+    /**
+     * @brief at - доступ по ключу(бросает исключение)
+     *
+     * @exception std::out_of_range в случае, если FlatMap не содержит key
+     */
+    T& at(const Key& key) {
+        std::size_t i = finder(key);
+        if (i == size()) throw std::out_of_range("FlatMap doesent contains such element");
+        return values_[i];
+    }
+
+    const T& at(const Key& key) const {
+        std::size_t i = finder(key);
+        if (i == size()) throw std::out_of_range("FlatMap doesent contains such element");
+        return values_[i];
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    T& at(const K& key) {
+        std::size_t i = finder(key);
+        if (i == size()) throw std::out_of_range("FlatMap doesent contains such element");
+        return values_[i];
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    const T& at(const K& key) const {
+        std::size_t i = finder(key);
+        if (i == size()) throw std::out_of_range("FlatMap doesent contains such element");
+        return values_[i];
+    }
+
+    /**
+     * @brief operator [] - вставляет пару (key, T()), если key нет, иначе - возвращает значение по ключу
+     */
+    T& operator[](const Key& key)
+        requires std::default_initializable<T>
+    {
+        return (*try_emplace(key).first).second;
+    }
+
+    T& operator[](Key&& key)
+        requires std::default_initializable<T>
+    {
+        return (*try_emplace(std::move(key)).first).second;
+    }
+
+    // EMPLACE BLOCK
+
+private:
+
+    /**
+     * @brief inserter - вставка ключа и значения на позицию i
+     *
+     * Если конструктор значения бросает исключение, вставленный ключ удаляется.
+     *
+     * @exception std::bad_alloc, исключения от конструкторов Key и T
+     */
+    template<typename K, typename... Args>
+    iterator inserter(std::size_t i, K&& key, Args&&... args) {
+        keys_.emplace(keys_.begin() + i, std::forward<K>(key));
+        try {
+            values_.emplace(values_.begin() + i, std::forward<Args>(args)...);
+        } catch (...) {
+            keys_.erase(keys_.begin() + i);
+            throw;
+        }
+        return begin() + i;
+    }
+
+public:
+
+    /**
+     * @brief try_emplace - вставка элемента, собранного из args, если ключа еще нет (O(n))
+     *
+     * @return std::pair<iterator, bool> - итератор на элемент и bool (вставлен ли элемент)
+     */
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        std::size_t i = lower_index(key);
+        if (i < size() && !comp_(key, keys_[i])) return { begin() + i, false };
+        return { inserter(i, key, std::forward<Args>(args)...), true };
+    }
+
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        std::size_t i = lower_index(key);
+        if (i < size() && !comp_(key, keys_[i])) return { begin() + i, false };
+        return { inserter(i, std::move(key), std::forward<Args>(args)...), true };
+    }
+
+    /**
+     * @brief emplace - сборка элемента из переданных параметров (O(n))
+     *
+     * @return std::pair<iterator, bool> - итератор на элемент и bool (вставлен ли элемент)
+     */
+    template<class... Args>
+    requires std::constructible_from<value_type, Args...>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type kv(std::forward<Args>(args)...);
+        return try_emplace(std::move(kv.first), std::move(kv.second));
+    }
+
+    /**
+     * @brief insert - вставка пары элементов
+     */
+    std::pair<iterator, bool> insert(const value_type& kv) { return try_emplace(kv.first, kv.second); }
+
+    /**
+     * @brief insert - вставка пары элементов перемещением
+     */
+    std::pair<iterator, bool> insert(value_type&& kv) { return try_emplace(std::move(kv.first), std::move(kv.second)); }
+
+    /**
+     * @brief insert_or_assign - вставка (key, obj) или присваивание obj существующему элементу
+     *
+     * @return std::pair<iterator, bool> - итератор на элемент и bool (true - вставлен, false - присвоен)
+     */
+    template<typename M>
+    requires std::constructible_from<T, M&&> && std::assignable_from<T&, M&&>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        std::size_t i = lower_index(key);
+        if (i < size() && !comp_(key, keys_[i])) {
+            values_[i] = std::forward<M>(obj);
+            return { begin() + i, false };
+        }
+        return { inserter(i, key, std::forward<M>(obj)), true };
+    }
+
+    template<typename M>
+    requires std::constructible_from<T, M&&> && std::assignable_from<T&, M&&>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+        std::size_t i = lower_index(key);
+        if (i < size() && !comp_(key, keys_[i])) {
+            values_[i] = std::forward<M>(obj);
+            return { begin() + i, false };
+        }
+        return { inserter(i, std::move(key), std::forward<M>(obj)), true };
+    }
+
+    // ERASE BLOCK
+
+    /**
+     * @brief erase - удаляет элемент, на который указывает итератор (O(n))
+     *
+     * @return iterator на следующий элемент
+     */
+    iterator erase(const_iterator position) {
+        std::size_t i = static_cast<std::size_t>(position - cbegin());
+        keys_.erase(keys_.begin() + i);
+        values_.erase(values_.begin() + i);
+        return begin() + i;
+    }
+
+    iterator erase(iterator position) { return erase(const_iterator(position)); }
+
+    /**
+     * @brief erase - удаляет элементы [first, last) одним сдвигом хвоста
+     *
+     * @return iterator на элемент, следовавший за удаленными
+     */
+    iterator erase(const_iterator first, const_iterator last) {
+        std::size_t i = static_cast<std::size_t>(first - cbegin());
+        std::size_t j = static_cast<std::size_t>(last - cbegin());
+        keys_.erase(keys_.begin() + i, keys_.begin() + j);
+        values_.erase(values_.begin() + i, values_.begin() + j);
+        return begin() + i;
+    }
+
+    /**
+     * @brief erase - удаляет элемент по ключу
+     *
+     * @return std::size_t - число удаленных элементов
+     */
+    std::size_t erase(const Key& key) {
+        std::size_t i = finder(key);
+        if (i == size()) return 0;
+        erase(cbegin() + i);
+        return 1;
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t erase(const K& key) {
+        std::size_t i = finder(key);
+        if (i == size()) return 0;
+        erase(cbegin() + i);
+        return 1;
+    }
+};
+
+} // namespace mystl
+
+#endif // FLATMAP_HPP
@@ -0,0 +1,583 @@
+#ifndef FROZENMAP_HPP
+#define FROZENMAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Map.hpp"
+#include "MapTraits.hpp"
+
+// CURRENT VERSION v0.1.2
+
+// CHANGELOG:
+// > Конструкторы из Map принимают любую раскладку узлов (wide_nodes, compact_nodes)
+// > Итераторы хранят указатель на массив, а не на снимок: перемещение и swap() их не портят
+
+// Неизменяемый снимок отсортированной таблицы (например, Map после загрузки справочника).
+// Элементы лежат в одном массиве в порядке Эйтцингера (обход дерева поиска в ширину):
+// корень в ячейке 1, дети ячейки k - в 2k и 2k + 1. Первые уровни дерева, через которые проходит
+// каждый поиск, занимают несколько соседних кэш-линий, а поиск не ветвится: на каждом шаге
+// k = 2k + (b[k] < key). Потомки на несколько уровней вниз лежат подряд, поэтому их кэш-линия
+// запрашивается заранее (prefetch), пока идут сравнения на текущем уровне.
+//
+//     mystl::Map<int, Row> table = load();
+//     mystl::FrozenMap<int, Row> frozen(std::move(table));   // O(n), значения перемещаются
+//
+// Обход по возрастанию ключей - это обход неявного дерева: ++ в среднем O(1), в худшем O(log n).
+
+namespace mystl {
+
+template<
+    typename Key,
+    typename T,
+    typename Compare = std::less<Key>,
+    typename Allocator = std::allocator<std::pair<const Key, T>>
+    >
+class FrozenMap {
+public:
+
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+
+private:
+
+    // Ячейка 0 не используется: так у ячейки k дети 2k и 2k + 1, а 0 обозначает end()
+    value_type* data_;
+    std::size_t size_;
+
+    Compare comp_;
+    Allocator alloc_;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    // Сколько элементов помещается в кэш-линию (степень двойки): потомки ячейки k через
+    // log2(prefetch_stride) уровней занимают ячейки [k * prefetch_stride, (k + 1) * prefetch_stride)
+    static constexpr std::size_t prefetch_stride =
+        sizeof(value_type) >= 64 ? 1 : std::bit_floor(64 / sizeof(value_type));
+
+    //LAYOUT BLOCK
+
+    /**
+     * @brief first_index - ячейка наименьшего ключа (самый левый узел), 0 для пустого массива
+     */
+    static std::size_t first_index(std::size_t n) noexcept {
+        if (n == 0) return 0;
+        std::size_t k = 1;
+        while (2 * k <= n) k = 2 * k;
+        return k;
+    }
+
+    /**
+     * @brief last_index - ячейка наибольшего ключа (самый правый узел), 0 для пустого массива
+     */
+    static std::size_t last_index(std::size_t n) noexcept {
+        if (n == 0) return 0;
+        std::size_t k = 1;
+        while (2 * k + 1 <= n) k = 2 * k + 1;
+        return k;
+    }
+
+    /**
+     * @brief next_index - следующая по порядку ключей ячейка (0 после наибольшей)
+     *
+     * Есть правое поддерево - его самый левый узел. Иначе подъем, пока k - правый ребенок (нечетный),
+     * и еще на один уровень.
+     */
+    static std::size_t next_index(std::size_t k, std::size_t n) noexcept {
+        if (2 * k + 1 <= n) {
+            k = 2 * k + 1;
+            while (2 * k <= n) k = 2 * k;
+            return k;
+        }
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    /**
+     * @brief prev_index - предыдущая по порядку ключей ячейка (для end() - наибольшая)
+     */
+    static std::size_t prev_index(std::size_t k, std::size_t n) noexcept {
+        if (k == 0) return last_index(n);
+        if (2 * k <= n) {
+            k = 2 * k;
+            while (2 * k + 1 <= n) k = 2 * k + 1;
+            return k;
+        }
+        return k >> (std::countr_zero(k) + 1);
+    }
+
+    //ITERATOR BLOCK
+
+    class common_iterator {
+    private:
+
+        friend class FrozenMap;
+
+        // Итератор держит сам массив, а не снимок: как и у других контейнеров,
+        // он остается валидным после перемещения или swap() снимка
+        const typename FrozenMap::value_type* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t index_ = 0;  // 0 - end()
+
+    public:
+
+        using value_type        = const typename FrozenMap::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = const typename FrozenMap::value_type&;
+        using pointer           = const typename FrozenMap::value_type*;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        common_iterator() = default;
+
+        common_iterator(const typename FrozenMap::value_type* data, std::size_t size, std::size_t index) noexcept
+            : data_(data), size_(size), index_(index) {}
+
+        reference operator * () const noexcept { return data_[index_]; }
+
+        pointer operator -> () const noexcept { return &data_[index_]; }
+
+        bool operator == (const common_iterator& other) const noexcept { return index_ == other.index_; }
+
+        common_iterator& operator ++ () noexcept {
+            index_ = next_index(index_, size_);
+            return *this;
+        }
+
+        common_iterator operator ++ (int) noexcept {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        common_iterator& operator -- () noexcept {
+            index_ = prev_index(index_, size_);
+            return *this;
+        }
+
+        common_iterator operator -- (int) noexcept {
+            auto copy = *this;
+            --(*this);
+            return copy;
+        }
+    };
+
+public:
+
+    //ORDINARY ITERATOR BLOCK
+
+    // Снимок только для чтения: оба итератора константные
+    using iterator = common_iterator;
+
+    using const_iterator = common_iterator;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    const_iterator begin() const noexcept { return iterator_at(first_index(size_)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator end() const noexcept { return iterator_at(0); }
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //BASIC FUNCTIONAL BLOCK
+
+private:
+
+    /**
+     * @brief iterator_at - итератор на ячейку k (0 - end())
+     */
+    const_iterator iterator_at(std::size_t k) const noexcept { return const_iterator(data_, size_, k); }
+
+    /**
+     * @brief builder - раскладывает n элементов отсортированного диапазона по ячейкам Эйтцингера
+     *
+     * Ячейки заполняются в порядке обхода дерева (next_index), поэтому вход читается один раз
+     * и последовательно, без сравнений.
+     *
+     * @param first - итератор на начало диапазона
+     * @param n - количество элементов
+     * @param make - make(alloc, place, it) конструирует элемент из *it в place
+     *
+     * @exception std::bad_alloc, исключения от make. Уже созданные элементы при этом уничтожаются
+     */
+    template<typename InputIt, typename Make>
+    void builder(InputIt first, std::size_t n, Make make) {
+        if (n == 0) return;
+
+        value_type* data = alloc_traits::allocate(alloc_, n + 1);
+        std::size_t k = first_index(n);
+        try {
+            for (; k != 0; ++first) {
+                make(alloc_, data + k, first);
+                k = next_index(k, n);
+            }
+        } catch (...) {
+            for (std::size_t j = first_index(n); j != k; j = next_index(j, n)) alloc_traits::destroy(alloc_, data + j);
+            alloc_traits::deallocate(alloc_, data, n + 1);
+            throw;
+        }
+
+        data_ = data;
+        size_ = n;
+    }
+
+    /**
+     * @brief destroy - уничтожение элементов и освобождение массива
+     */
+    void destroy() noexcept {
+        if (data_ == nullptr) return;
+        for (std::size_t k = 1; k <= size_; ++k) alloc_traits::destroy(alloc_, data_ + k);
+        alloc_traits::deallocate(alloc_, data_, size_ + 1);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+public:
+
+    /**
+     * @brief Деструктор
+     */
+    ~FrozenMap() { destroy(); }
+
+    /**
+     * @brief Дефолт конструктор (пустой снимок)
+     */
+    FrozenMap() : FrozenMap(Compare(), Allocator()) {}
+
+    /**
+     * @brief Конструктор из компаратора и аллокатора (пустой снимок)
+     */
+    explicit FrozenMap(const Compare& comp, const Allocator& alloc = Allocator()) :
+        data_(nullptr),
+        size_(0),
+        comp_(comp),
+        alloc_(alloc) {}
+
+    /**
+     * @brief FrozenMap - снимок отсортированного диапазона без повторов за O(n)
+     *
+     * @param first - итератор на начало диапазона, отсортированного по comp
+     * @param last - итератор на конец диапазона
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора value_type
+     */
+    template<std::forward_iterator ForwardIt>
+    requires std::constructible_from<value_type, std::iter_reference_t<ForwardIt>>
+    FrozenMap(sorted_unique_t, ForwardIt first, ForwardIt last,
+              const Compare& comp = Compare(), const Allocator& alloc = Allocator()) : FrozenMap(comp, alloc)
+    {
+        builder(first, static_cast<std::size_t>(std::distance(first, last)),
+                [](Allocator& a, value_type* place, ForwardIt it) { alloc_traits::construct(a, place, *it); });
+    }
+
+    /**
+     * @brief FrozenMap - снимок Map (копирование элементов)
+     *
+     * @param map - исходная Map (ее компаратор должен упорядочивать так же, как comp)
+     */
+    template<typename MapAllocator, typename Augmentation, typename NodeLayout>
+    explicit FrozenMap(const Map<Key, T, Compare, MapAllocator, Augmentation, NodeLayout>& map,
+                       const Compare& comp = Compare(), const Allocator& alloc = Allocator()) : FrozenMap(comp, alloc)
+    {
+        builder(map.begin(), map.size(),
+                [](Allocator& a, value_type* place, auto it) { alloc_traits::construct(a, place, *it); });
+    }
+
+    /**
+     * @brief FrozenMap - снимок Map с перемещением значений (Map остается пустой)
+     *
+     * @param map - исходная Map (ключи копируются, значения перемещаются)
+     */
+    template<typename MapAllocator, typename Augmentation, typename NodeLayout>
+    explicit FrozenMap(Map<Key, T, Compare, MapAllocator, Augmentation, NodeLayout>&& map,
+                       const Compare& comp = Compare(), const Allocator& alloc = Allocator()) : FrozenMap(comp, alloc)
+    {
+        builder(map.begin(), map.size(),
+                [](Allocator& a, value_type* place, auto it) { alloc_traits::construct(a, place, it->first, std::move(it->second)); });
+        map.clear();
+    }
+
+    /**
+     * @brief Конструктор копирования (та же раскладка, без перестроения)
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора копирования Key, T
+     */
+    FrozenMap(const FrozenMap& other)
+        : FrozenMap(other, alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    /**
+     * @brief Конструктор копирования с заданным аллокатором
+     */
+    FrozenMap(const FrozenMap& other, const Allocator& alloc) : FrozenMap(other.comp_, alloc) {
+        if (other.size_ == 0) return;
+
+        value_type* data = alloc_traits::allocate(alloc_, other.size_ + 1);
+        std::size_t k = 1;
+        try {
+            for (; k <= other.size_; ++k) alloc_traits::construct(alloc_, data + k, other.data_[k]);
+        } catch (...) {
+            for (std::size_t j = 1; j < k; ++j) alloc_traits::destroy(alloc_, data + j);
+            alloc_traits::deallocate(alloc_, data, other.size_ + 1);
+            throw;
+        }
+        data_ = data;
+        size_ = other.size_;
+    }
+
+    /**
+     * @brief Конструктор перемещения
+     *
+     * @param other - другой FrozenMap (остается пустым)
+     */
+    FrozenMap(FrozenMap&& other) noexcept :
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        comp_(other.comp_),
+        alloc_(other.alloc_) {}
+
+    /**
+     * @brief operator = - копирующий оператор присваивания
+     *
+     * Аллокатор other перенимается, только если propagate_on_container_copy_assignment.
+     */
+    FrozenMap& operator = (const FrozenMap& other) {
+        if (this != &other) {
+            constexpr bool propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+            FrozenMap temp(other, propagate ? other.alloc_ : alloc_);
+            swap_storage(temp);
+            if constexpr (propagate) std::swap(alloc_, temp.alloc_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief operator = - перемещающий оператор присваивания
+     *
+     * Аллокатор other перенимается, только если propagate_on_container_move_assignment.
+     * При неравных аллокаторах без распространения элементы копируются.
+     */
+    FrozenMap& operator = (FrozenMap&& other) {
+        if (this != &other) {
+            constexpr bool propagate = alloc_traits::propagate_on_container_move_assignment::value;
+
+            if constexpr (!propagate && !alloc_traits::is_always_equal::value) {
+                if (!(alloc_ == other.alloc_)) {
+                    FrozenMap temp(other, alloc_);
+                    swap_storage(temp);
+                    return *this;
+                }
+            }
+
+            destroy();
+            swap_storage(other);
+            if constexpr (propagate) std::swap(alloc_, other.alloc_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief swap - обмен содержимым двух FrozenMap
+     *
+     * Аллокаторы обмениваются, только если propagate_on_container_swap; иначе они должны быть равны.
+     */
+    void swap(FrozenMap& other) noexcept {
+        swap_storage(other);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) std::swap(alloc_, other.alloc_);
+    }
+
+    /**
+     * @brief size - количество элементов
+     */
+    std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief empty - Пуст ли снимок?
+     */
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief get_allocator - копия аллокатора
+     */
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+private:
+
+    /**
+     * @brief swap_storage - обмен массивами и компараторами (без аллокаторов)
+     */
+    void swap_storage(FrozenMap& other) noexcept {
+        using std::swap;
+        swap(data_, other.data_);
+        swap(size_, other.size_);
+        swap(comp_, other.comp_);
+    }
+
+    //FINDER BLOCK
+
+    // Гетерогенный поиск для прозрачного компаратора (см. detail::transparent_key)
+    template<typename K>
+    static constexpr bool transparent_key = detail::transparent_key<K, std::tuple<Compare>, const_iterator>;
+
+    /**
+     * @brief prefetch - подсказка процессору загрузить кэш-линию с ячейкой k
+     *
+     * Ячейки может и не быть (последние уровни): prefetch по чужому адресу не обращается к памяти,
+     * а адрес считается в целых числах, без указателя за пределы массива. Проверка k <= size_
+     * обходится дороже лишних подсказок.
+     */
+    void prefetch(std::size_t k) const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(data_) + k * sizeof(value_type)));
+#else
+        (void)k;
+#endif
+    }
+
+    /**
+     * @brief descend - спуск без ветвлений: ячейка первого элемента, для которого go_right ложно (0 - нет такого)
+     *
+     * k = 2k + go_right(b[k]) проходит по дереву до выхода за массив. Путь в двоичной записи k:
+     * последний поворот налево (к ответу) - последний ноль, поэтому ответ - k без хвоста из единиц и этого нуля.
+     */
+    template<typename GoRight>
+    std::size_t descend(GoRight go_right) const {
+        std::size_t k = 1;
+        while (k <= size_) {
+            prefetch(k * prefetch_stride);
+            k = 2 * k + (go_right(data_[k].first) ? 1 : 0);
+        }
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    /**
+     * @brief lower_index - ячейка первого ключа, не меньшего key
+     */
+    template<typename K>
+    std::size_t lower_index(const K& key) const {
+        return descend([&](const Key& k) { return comp_(k, key); });
+    }
+
+    /**
+     * @brief upper_index - ячейка первого ключа, большего key
+     */
+    template<typename K>
+    std::size_t upper_index(const K& key) const {
+        return descend([&](const Key& k) { return !comp_(key, k); });
+    }
+
+    /**
+     * @brief finder - ячейка с ключом key или 0
+     */
+    template<typename K>
+    std::size_t finder(const K& key) const {
+        std::size_t k = lower_index(key);
+        return k != 0 && !comp_(key, data_[k].first) ? k : 0;
+    }
+
+public:
+
+    /**
+     * @brief find - поиск по ключу
+     *
+     * @return const_iterator на элемент или end()
+     */
+    const_iterator find(const Key& key) const { return iterator_at(finder(key)); }
+
+    /**
+     * @brief find - гетерогенный поиск (только для прозрачного компаратора)
+     */
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator find(const K& key) const { return iterator_at(finder(key)); }
+
+    /**
+     * @brief contains - проверяет есть ли ключ в снимке
+     */
+    bool contains(const Key& key) const { return finder(key) != 0; }
+
+    template<typename K>
+    requires transparent_key<K>
+    bool contains(const K& key) const { return finder(key) != 0; }
+
+    /**
+     * @brief count - количество элементов с ключом key (0 или 1)
+     */
+    std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    /**
+     * @brief lower_bound - первый элемент с ключом не меньше key
+     */
+    const_iterator lower_bound(const Key& key) const { return iterator_at(lower_index(key)); }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator lower_bound(const K& key) const { return iterator_at(lower_index(key)); }
+
+    /**
+     * @brief upper_bound - первый элемент с ключом больше key
+     */
+    const_iterator upper_bound(const Key& key) const { return iterator_at(upper_index(key)); }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator upper_bound(const K& key) const { return iterator_at(upper_index(key)); }
+
+    /**
+     * @brief equal_range - диапазон элементов с ключом key (пустой или из одного элемента)
+     */
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+        std::size_t k = finder(key);
+        if (k == 0) {
+            const_iterator it = lower_bound(key);
+            return { it, it };
+        }
+        return { iterator_at(k), iterator_at(next_index(k, size_)) };
+    }
+
+    /**
+     * @brief at - доступ по ключу(бросает исключение)
+     *
+     * @exception std::out_of_range в случае, если FrozenMap не содержит key
+     */
+    const T& at(const Key& key) const {
+        std::size_t k = finder(key);
+        if (k == 0) throw std::out_of_range("FrozenMap doesent contains such element");
+        return data_[k].second;
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    const T& at(const K& key) const {
+        std::size_t k = finder(key);
+        if (k == 0) throw std::out_of_range("FrozenMap doesent contains such element");
+        return data_[k].second;
+    }
+};
+
+} // namespace mystl
+
+#endif // FROZENMAP_HPP
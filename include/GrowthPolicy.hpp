@@ -0,0 +1,125 @@
+#ifndef GROWTHPOLICY_HPP
+#define GROWTHPOLICY_HPP
+
+#include <cstddef>
+#include <concepts>
+#include <limits>
+#include <bit>
+#include <algorithm>
+
+// CURRENT VERSION v0.1.0
+
+namespace mystl {
+
+//   ~~Интерфейс политики роста~~
+//
+//   struct MyGrowth {
+//       template<typename T>
+//       static constexpr std::size_t next_capacity(std::size_t cap, std::size_t required) noexcept;
+//   };
+//
+//   cap      - текущая ёмкость контейнера
+//   required - минимальная ёмкость, которая нужна прямо сейчас (всегда > cap)
+//   Результат обязан быть >= required.
+
+/**
+ * @brief growth_policy - концепт политики роста для контейнеров элементов T
+ */
+template<typename Policy, typename T>
+concept growth_policy = requires(std::size_t cap, std::size_t required) {
+    { Policy::template next_capacity<T>(cap, required) } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * @brief growth_min_capacity - минимальная ёмкость первой аллокации
+ *
+ * Первый буфер занимает не меньше 64 байт (одна кэш-линия), чтобы пустой массив
+ * не проходил через цепочку 1, 2, 4, 8... крошечных аллокаций.
+ */
+template<typename T>
+inline constexpr std::size_t growth_min_capacity = std::max<std::size_t>(1, 64 / sizeof(T));
+
+/**
+ * @brief DoublingGrowth - рост в 2 раза (политика по умолчанию)
+ *
+ * Минимум перевыделений, но до 2x лишней памяти на верхней границе.
+ */
+struct DoublingGrowth {
+    template<typename T>
+    static constexpr std::size_t next_capacity(std::size_t cap, std::size_t required) noexcept {
+        std::size_t grown = cap > std::numeric_limits<std::size_t>::max() / 2 ? required : 2 * cap;
+        return std::max({ grown, required, growth_min_capacity<T> });
+    }
+};
+
+/**
+ * @brief OneAndHalfGrowth - рост в 1.5 раза
+ *
+ * Больше перевыделений, но меньше неиспользуемой памяти. К тому же освобожденные
+ * ранее блоки в сумме рано или поздно вмещают новый, и аллокатор может их переиспользовать.
+ */
+struct OneAndHalfGrowth {
+    template<typename T>
+    static constexpr std::size_t next_capacity(std::size_t cap, std::size_t required) noexcept {
+        std::size_t grown = cap > std::numeric_limits<std::size_t>::max() / 3 * 2 ? required : cap + cap / 2;
+        return std::max({ grown, required, growth_min_capacity<T> });
+    }
+};
+
+/**
+ * @brief SizeClassGrowth - рост в 1.5 раза с округлением до размерных классов jemalloc
+ *
+ * jemalloc все равно округляет запрос до своего размерного класса
+ * (шаг 16 байт до 128, далее 4 класса на каждую степень двойки),
+ * поэтому хвост аллокации отдается под элементы, а не пропадает впустую.
+ */
+struct SizeClassGrowth {
+    /**
+     * @brief round_to_size_class - округление количества байт вверх до размерного класса
+     *
+     * @param bytes - запрошенный размер
+     *
+     * @return std::size_t - размер класса, в который попадет запрос
+     */
+    static constexpr std::size_t round_to_size_class(std::size_t bytes) noexcept {
+        if (bytes <= 8) return 8;
+        if (bytes <= 128) return (bytes + 15) & ~std::size_t(15);
+
+        // 2^k < bytes <= 2^(k + 1), внутри интервала 4 класса с шагом 2^(k - 2)
+        std::size_t k = std::bit_width(bytes - 1) - 1;
+        std::size_t step = std::size_t(1) << (k - 2);
+        if (bytes > std::numeric_limits<std::size_t>::max() - step) return bytes;
+        return (bytes + step - 1) & ~(step - 1);
+    }
+
+    template<typename T>
+    static constexpr std::size_t next_capacity(std::size_t cap, std::size_t required) noexcept {
+        std::size_t want = std::max(OneAndHalfGrowth::next_capacity<T>(cap, required), required);
+        if (want > std::numeric_limits<std::size_t>::max() / sizeof(T)) return want;
+        return round_to_size_class(want * sizeof(T)) / sizeof(T);
+    }
+};
+
+/**
+ * @brief FixedChunkGrowth - рост фиксированными порциями по Chunk элементов
+ *
+ * Линейный рост: перевыделений O(n / Chunk), зато лишней памяти не больше Chunk элементов.
+ * Подходит, когда итоговый размер примерно известен заранее.
+ *
+ * @tparam Chunk - размер порции в элементах
+ */
+template<std::size_t Chunk>
+requires (Chunk > 0)
+struct FixedChunkGrowth {
+    template<typename T>
+    static constexpr std::size_t next_capacity(std::size_t cap, std::size_t required) noexcept {
+        std::size_t grown = cap > std::numeric_limits<std::size_t>::max() - Chunk ? required : cap + Chunk;
+        return std::max(grown, required);
+    }
+};
+
+using DefaultGrowth = DoublingGrowth;
+
+} // namespace mystl
+
+#endif // GROWTHPOLICY_HPP
@@ -0,0 +1,1115 @@
+#ifndef HASHMAP_HPP
+#define HASHMAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ArrayAlgorithms.hpp"
+#include "MapTraits.hpp"
+#include "Relocation.hpp"
+
+// CURRENT VERSION v0.1.0
+
+// Хеш-таблица с открытой адресацией в духе SwissTable. Элементы лежат прямо в массиве слотов,
+// а рядом - массив управляющих байтов, по одному на слот: пусто, удален или 7 младших бит хеша (H2)
+// занятого слота. Поиск сравнивает H2 сразу с 16 управляющими байтами (одна инструкция SSE2,
+// без SSE2 - побайтовый цикл) и обращается к слоту только при совпадении, поэтому в среднем
+// на поиск приходится один промах кэша. Максимальная заполненность - 7/8.
+//
+// Отличия от Map:
+// > Порядок обхода не определен; вставка может перестроить таблицу и сделать невалидными все итераторы
+//   (удаление - только итератор на удаленный элемент)
+// > Если хеш-функция не noexcept, при перестроении хеши всех элементов считаются до перемещения первого
+//   из них: исключение из хеш-функции оставляет таблицу нетронутой
+
+namespace mystl::detail {
+
+using ctrl_t = std::int8_t;
+
+// Управляющие байты. Занятый слот хранит H2 (0..127), поэтому у всех особых значений старший бит выставлен
+inline constexpr ctrl_t ctrl_empty = -128;
+inline constexpr ctrl_t ctrl_deleted = -2;
+inline constexpr ctrl_t ctrl_sentinel = -1;  // стоит после последнего слота: на нем останавливается обход
+
+// Управляющие байты пустой таблицы без выделенной памяти: поиск сразу видит пустой слот
+alignas(16) inline constexpr ctrl_t empty_group[16] = {
+    ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty
+};
+
+/**
+ * @brief ControlGroup - 16 подряд идущих управляющих байтов
+ *
+ * match-функции возвращают битовую маску: бит i выставлен, если подходит байт i.
+ */
+class ControlGroup {
+public:
+
+    static constexpr std::size_t width = 16;
+
+#if defined(__SSE2__)
+
+    explicit ControlGroup(const ctrl_t* p) noexcept : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    std::uint32_t match(ctrl_t h2) const noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+    }
+
+    std::uint32_t match_empty() const noexcept { return match(ctrl_empty); }
+
+    // Пустые и удаленные - все байты меньше ctrl_sentinel
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl_)));
+    }
+
+private:
+
+    __m128i ctrl_;
+
+#else
+
+    explicit ControlGroup(const ctrl_t* p) noexcept { std::memcpy(ctrl_, p, width); }
+
+    std::uint32_t match(ctrl_t h2) const noexcept {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < width; ++i) mask |= std::uint32_t(ctrl_[i] == h2) << i;
+        return mask;
+    }
+
+    std::uint32_t match_empty() const noexcept { return match(ctrl_empty); }
+
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < width; ++i) mask |= std::uint32_t(ctrl_[i] < ctrl_sentinel) << i;
+        return mask;
+    }
+
+private:
+
+    ctrl_t ctrl_[width];
+
+#endif
+};
+
+} // namespace mystl::detail
+
+namespace mystl {
+
+template<
+    typename Key,
+    typename T,
+    typename Hash = std::hash<Key>,
+    typename KeyEqual = std::equal_to<Key>,
+    typename Allocator = std::allocator<std::pair<const Key, T>>
+    >
+class HashMap {
+public:
+
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+
+private:
+
+    using ctrl_t = detail::ctrl_t;
+    using Group = detail::ControlGroup;
+
+    static constexpr std::size_t group_width = Group::width;
+
+    // Емкость всегда 2^k - 1: позиция считается маской, а управляющих байтов capacity_ + group_width
+    // (слоты, ctrl_sentinel и копии первых group_width - 1 байтов для чтения группы через конец)
+    static constexpr std::size_t min_capacity = group_width - 1;
+
+    ctrl_t* ctrl_;
+    value_type* slots_;
+    std::size_t capacity_;
+    std::size_t size_;
+    std::size_t growth_left_;  // сколько еще пустых слотов можно занять до перестроения
+
+    Hash hash_;
+    KeyEqual eq_;
+    Allocator alloc_;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    using ctrl_allocator = typename alloc_traits::template rebind_alloc<ctrl_t>;
+    ctrl_allocator ctrl_alloc_;
+
+    // Временный массив хешей для перестроения с хеш-функцией, которая может бросить
+    using hash_allocator = typename alloc_traits::template rebind_alloc<std::uint64_t>;
+
+    // Перенос элемента в новую таблицу не бросает исключений: исходный элемент можно перемещать
+    static constexpr bool nothrow_relocation =
+        allocator_relocates_bitwise_v<value_type, Allocator> || std::is_nothrow_move_constructible_v<value_type>;
+
+    static constexpr bool nothrow_hash = std::is_nothrow_invocable_v<const Hash&, const Key&>;
+
+    //ITERATOR BLOCK
+
+    template <bool IsConst>
+    class common_iterator {
+    private:
+
+        using ConditionalPtr = std::conditional_t<IsConst, const typename HashMap::value_type*, typename HashMap::value_type*>;
+        using ConditionalRef = std::conditional_t<IsConst, const typename HashMap::value_type&, typename HashMap::value_type&>;
+        using ConditionalType = std::conditional_t<IsConst, const typename HashMap::value_type, typename HashMap::value_type>;
+
+        friend class HashMap;
+
+        const ctrl_t* ctrl_ = nullptr;
+        ConditionalPtr slot_ = nullptr;
+
+        /**
+         * @brief skip_free - сдвиг вперед до занятого слота или ctrl_sentinel (целыми группами)
+         */
+        void skip_free() noexcept {
+            while (*ctrl_ < detail::ctrl_sentinel) {
+                int shift = std::countr_one(Group(ctrl_).match_empty_or_deleted());
+                ctrl_ += shift;
+                slot_ += shift;
+            }
+        }
+
+    public:
+
+        using value_type        = ConditionalType;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = ConditionalRef;
+        using pointer           = ConditionalPtr;
+        using iterator_category = std::forward_iterator_tag;
+
+        common_iterator() = default;
+
+        common_iterator(const ctrl_t* ctrl, ConditionalPtr slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+        /**
+         * @brief Конструктор const_iterator из iterator
+         */
+        template<bool OtherConst>
+        requires (IsConst && !OtherConst)
+        common_iterator(const common_iterator<OtherConst>& other) noexcept : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+        ConditionalRef operator * () const noexcept { return *slot_; }
+
+        ConditionalPtr operator -> () const noexcept { return slot_; }
+
+        template <bool OtherConst>
+        bool operator == (const common_iterator<OtherConst>& other) const noexcept { return ctrl_ == other.ctrl_; }
+
+        common_iterator& operator ++ () noexcept {
+            ++ctrl_;
+            ++slot_;
+            skip_free();
+            return *this;
+        }
+
+        common_iterator operator ++ (int) noexcept {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+    };
+
+public:
+
+    //ORDINARY ITERATOR BLOCK
+
+    using iterator = common_iterator<false>;
+
+    using const_iterator = common_iterator<true>;
+
+    iterator begin() noexcept { return iterator_at(0); }
+    const_iterator begin() const noexcept { return const_cast<HashMap*>(this)->iterator_at(0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator end() const noexcept { return const_iterator(ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+
+    /**
+     * @brief iterator_at - итератор на первый занятый слот, начиная с i
+     */
+    iterator iterator_at(std::size_t i) noexcept {
+        iterator it(ctrl_ + i, slots_ + i);
+        it.skip_free();
+        return it;
+    }
+
+    //HASHING BLOCK
+
+    /**
+     * @brief mix - перемешивание хеша: std::hash для целых - тождественная функция,
+     *        а H1 и H2 должны зависеть от всех бит ключа
+     */
+    static std::uint64_t mix(std::size_t h) noexcept {
+        std::uint64_t x = h;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    static std::size_t h1(std::uint64_t h) noexcept { return static_cast<std::size_t>(h >> 7); }
+
+    static ctrl_t h2(std::uint64_t h) noexcept { return static_cast<ctrl_t>(h & 0x7F); }
+
+    template<typename K>
+    std::uint64_t hash_of(const K& key) const { return mix(hash_(key)); }
+
+    /**
+     * @brief ProbeSequence - квадратичное пробирование группами: смещения pos, pos + 16, pos + 48, ...
+     *
+     * При емкости 2^k - 1 последовательность обходит все группы таблицы.
+     */
+    struct ProbeSequence {
+        std::size_t mask;
+        std::size_t offset;
+        std::size_t index = 0;
+
+        ProbeSequence(std::size_t hash, std::size_t capacity) noexcept : mask(capacity), offset(hash & capacity) {}
+
+        std::size_t slot(std::uint32_t i) const noexcept { return (offset + i) & mask; }
+
+        void next() noexcept {
+            index += group_width;
+            offset = (offset + index) & mask;
+        }
+    };
+
+    /**
+     * @brief capacity_to_growth - сколько элементов помещается в таблицу емкости capacity при заполненности 7/8
+     */
+    static constexpr std::size_t capacity_to_growth(std::size_t capacity) noexcept { return capacity - capacity / 8; }
+
+    /**
+     * @brief capacity_for - минимальная допустимая емкость для size элементов
+     */
+    static std::size_t capacity_for(std::size_t size) noexcept {
+        if (size == 0) return 0;
+        std::size_t required = size + (size - 1) / 7;
+        return std::max(min_capacity, std::bit_ceil(required + 1) - 1);
+    }
+
+    /**
+     * @brief set_ctrl - запись управляющего байта слота i (и его копии за ctrl_sentinel)
+     */
+    static void set_ctrl(ctrl_t* ctrl, std::size_t capacity, std::size_t i, ctrl_t value) noexcept {
+        ctrl[i] = value;
+        ctrl[((i - (group_width - 1)) & capacity) + (group_width - 1)] = value;
+    }
+
+    /**
+     * @brief free_slot - первый пустой или удаленный слот на пути пробирования хеша hash
+     */
+    static std::size_t free_slot(const ctrl_t* ctrl, std::size_t capacity, std::uint64_t hash) noexcept {
+        ProbeSequence seq(h1(hash), capacity);
+        while (true) {
+            std::uint32_t mask = Group(ctrl + seq.offset).match_empty_or_deleted();
+            if (mask != 0) return seq.slot(std::countr_zero(mask));
+            seq.next();
+        }
+    }
+
+    //STORAGE BLOCK
+
+    /**
+     * @brief allocate_storage - управляющие байты (все пустые) и слоты для емкости capacity
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     */
+    std::pair<ctrl_t*, value_type*> allocate_storage(std::size_t capacity) {
+        ctrl_t* ctrl = std::allocator_traits<ctrl_allocator>::allocate(ctrl_alloc_, capacity + group_width);
+        value_type* slots;
+        try {
+            slots = alloc_traits::allocate(alloc_, capacity);
+        } catch (...) {
+            std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc_, ctrl, capacity + group_width);
+            throw;
+        }
+        std::memset(ctrl, static_cast<unsigned char>(detail::ctrl_empty), capacity + group_width);
+        ctrl[capacity] = detail::ctrl_sentinel;
+        return { ctrl, slots };
+    }
+
+    /**
+     * @brief deallocate_storage - освобождение памяти таблицы (элементы уже уничтожены)
+     */
+    void deallocate_storage(ctrl_t* ctrl, value_type* slots, std::size_t capacity) noexcept {
+        if (capacity == 0) return;
+        std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc_, ctrl, capacity + group_width);
+        alloc_traits::deallocate(alloc_, slots, capacity);
+    }
+
+    /**
+     * @brief destroy_elements - уничтожение всех элементов (управляющие байты не меняются)
+     */
+    void destroy_elements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type> || !allocator_relocates_bitwise_v<value_type, Allocator>) {
+            for (std::size_t i = 0; i < capacity_; ++i)
+                if (ctrl_[i] >= 0) alloc_traits::destroy(alloc_, slots_ + i);
+        }
+    }
+
+    /**
+     * @brief reset_empty - пустая таблица без памяти
+     */
+    void reset_empty() noexcept {
+        ctrl_ = const_cast<ctrl_t*>(detail::empty_group);
+        slots_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growth_left_ = 0;
+    }
+
+    /**
+     * @brief resize - перенос элементов в новую таблицу емкости new_capacity (удаленные слоты исчезают)
+     *
+     * Если value_type перемещается без исключений (или побайтово), исходные элементы перемещаются,
+     * а хеши для хеш-функции без noexcept считаются заранее, поэтому сам перенос не бросает исключений.
+     * Иначе элементы копируются. В обоих случаях при исключении таблица не меняется.
+     *
+     * @exception std::bad_alloc, исключения от хеш-функции и конструктора копирования value_type
+     */
+    void resize(std::size_t new_capacity) {
+        auto [ctrl, slots] = allocate_storage(new_capacity);
+        auto hash_at = [this](std::size_t i) { return hash_of(slots_[i].first); };
+
+        if constexpr (nothrow_relocation && nothrow_hash) {
+            relocate_all(ctrl, slots, new_capacity, hash_at);
+        } else if constexpr (nothrow_relocation) {
+            if (size_ > 0) {
+                try {
+                    relocate_all_prehashed(ctrl, slots, new_capacity);
+                } catch (...) {
+                    deallocate_storage(ctrl, slots, new_capacity);
+                    throw;
+                }
+            }
+        } else {
+            try {
+                relocate_all(ctrl, slots, new_capacity, hash_at);
+            } catch (...) {
+                for (std::size_t i = 0; i < new_capacity; ++i)
+                    if (ctrl[i] >= 0) alloc_traits::destroy(alloc_, slots + i);
+                deallocate_storage(ctrl, slots, new_capacity);
+                throw;
+            }
+            destroy_elements();
+        }
+
+        deallocate_storage(ctrl_, slots_, capacity_);
+        ctrl_ = ctrl;
+        slots_ = slots;
+        capacity_ = new_capacity;
+        growth_left_ = capacity_to_growth(new_capacity) - size_;
+    }
+
+    /**
+     * @brief relocate_all - перенос (или копирование, см. resize) всех элементов в новые массивы
+     *
+     * @param hash_at - хеш элемента в слоте i
+     */
+    template<typename HashAt>
+    void relocate_all(ctrl_t* ctrl, value_type* slots, std::size_t capacity, HashAt hash_at) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] < 0) continue;
+
+            std::uint64_t hash = hash_at(i);
+            std::size_t j = free_slot(ctrl, capacity, hash);
+            if constexpr (allocator_relocates_bitwise_v<value_type, Allocator>) {
+                std::memcpy(static_cast<void*>(slots + j), static_cast<const void*>(slots_ + i), sizeof(value_type));
+            } else if constexpr (std::is_nothrow_move_constructible_v<value_type>) {
+                alloc_traits::construct(alloc_, slots + j, std::move(slots_[i]));
+                alloc_traits::destroy(alloc_, slots_ + i);
+            } else {
+                alloc_traits::construct(alloc_, slots + j, std::as_const(slots_[i]));
+            }
+            set_ctrl(ctrl, capacity, j, h2(hash));
+        }
+    }
+
+    /**
+     * @brief relocate_all_prehashed - перенос с хеш-функцией без noexcept: сначала хеши всех элементов,
+     *        потом перемещение (уже без вызовов хеш-функции)
+     *
+     * @exception std::bad_alloc, исключения от хеш-функции (элементы еще не тронуты)
+     */
+    void relocate_all_prehashed(ctrl_t* ctrl, value_type* slots, std::size_t capacity) {
+        hash_allocator alloc(alloc_);
+        std::uint64_t* hashes = std::allocator_traits<hash_allocator>::allocate(alloc, capacity_);
+        try {
+            for (std::size_t i = 0; i < capacity_; ++i)
+                if (ctrl_[i] >= 0) hashes[i] = hash_of(slots_[i].first);
+        } catch (...) {
+            std::allocator_traits<hash_allocator>::deallocate(alloc, hashes, capacity_);
+            throw;
+        }
+        relocate_all(ctrl, slots, capacity, [hashes](std::size_t i) noexcept { return hashes[i]; });
+        std::allocator_traits<hash_allocator>::deallocate(alloc, hashes, capacity_);
+    }
+
+    /**
+     * @brief grow - освобождение места под вставку: перестроение в той же емкости, если живые элементы
+     *        занимают не больше 25/32 слотов (остальные до предела 7/8 - удаленные), иначе удвоение
+     */
+    void grow() {
+        if (capacity_ == 0) resize(min_capacity);
+        else if (size_ * 32 <= capacity_ * 25) resize(capacity_);
+        else resize(capacity_ * 2 + 1);
+    }
+
+public:
+
+    /**
+     * @brief Деструктор
+     */
+    ~HashMap() {
+        destroy_elements();
+        deallocate_storage(ctrl_, slots_, capacity_);
+    }
+
+    /**
+     * @brief Дефолт конструктор (память не выделяется до первой вставки)
+     */
+    HashMap() : HashMap(0) {}
+
+    /**
+     * @brief Конструктор с начальным числом элементов, хеш-функцией, сравнением ключей и аллокатором
+     *
+     * @param size - сколько элементов таблица вместит без перестроения
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     */
+    explicit HashMap(std::size_t size,
+                     const Hash& hash = Hash(),
+                     const KeyEqual& eq = KeyEqual(),
+                     const Allocator& alloc = Allocator()) :
+        hash_(hash),
+        eq_(eq),
+        alloc_(alloc),
+        ctrl_alloc_(alloc)
+    {
+        reset_empty();
+        if (size > 0) resize(capacity_for(size));
+    }
+
+    /**
+     * @brief HashMap - конструктор от аллокатора
+     */
+    explicit HashMap(const Allocator& alloc) : HashMap(0, Hash(), KeyEqual(), alloc) {}
+
+    /**
+     * @brief HashMap - конструктор от диапазона
+     *
+     * @param first - итератор на начало диапазона
+     * @param last - итератор на конец диапазона
+     */
+    template<typename InputIt>
+    requires std::constructible_from<value_type, std::iter_reference_t<InputIt>>
+    HashMap(InputIt first, InputIt last,
+            std::size_t size = 0,
+            const Hash& hash = Hash(),
+            const KeyEqual& eq = KeyEqual(),
+            const Allocator& alloc = Allocator()) : HashMap(size, hash, eq, alloc)
+    {
+        if constexpr (std::forward_iterator<InputIt>) reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first) emplace(*first);
+    }
+
+    /**
+     * @brief HashMap - конструктор от std::initializer_list<std::pair<const Key, T>>
+     */
+    HashMap(std::initializer_list<value_type> init,
+            std::size_t size = 0,
+            const Hash& hash = Hash(),
+            const KeyEqual& eq = KeyEqual(),
+            const Allocator& alloc = Allocator()) : HashMap(init.begin(), init.end(), size, hash, eq, alloc) {}
+
+    /**
+     * @brief Конструктор копирования: копия с той же емкостью и расположением элементов (без перехеширования)
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора копирования Key, T
+     */
+    HashMap(const HashMap& other)
+        : HashMap(other, alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    /**
+     * @brief Конструктор копирования с заданным аллокатором
+     */
+    HashMap(const HashMap& other, const Allocator& alloc) : HashMap(0, other.hash_, other.eq_, alloc) {
+        if (other.size_ == 0) return;
+
+        auto [ctrl, slots] = allocate_storage(other.capacity_);
+        std::size_t i = 0;
+        try {
+            for (; i < other.capacity_; ++i)
+                if (other.ctrl_[i] >= 0) alloc_traits::construct(alloc_, slots + i, other.slots_[i]);
+        } catch (...) {
+            for (std::size_t j = 0; j < i; ++j)
+                if (other.ctrl_[j] >= 0) alloc_traits::destroy(alloc_, slots + j);
+            deallocate_storage(ctrl, slots, other.capacity_);
+            throw;
+        }
+        std::memcpy(ctrl, other.ctrl_, other.capacity_ + group_width);
+
+        ctrl_ = ctrl;
+        slots_ = slots;
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        growth_left_ = other.growth_left_;
+    }
+
+    /**
+     * @brief Конструктор перемещения
+     *
+     * @param other - другой HashMap (остается пустым)
+     */
+    HashMap(HashMap&& other) noexcept :
+        ctrl_(other.ctrl_),
+        slots_(other.slots_),
+        capacity_(other.capacity_),
+        size_(other.size_),
+        growth_left_(other.growth_left_),
+        hash_(other.hash_),
+        eq_(other.eq_),
+        alloc_(other.alloc_),
+        ctrl_alloc_(other.ctrl_alloc_)
+    {
+        other.reset_empty();
+    }
+
+    /**
+     * @brief Конструктор перемещения с заданным аллокатором
+     *
+     * Если аллокаторы равны, таблица забирается целиком, иначе элементы перемещаются по одному.
+     */
+    HashMap(HashMap&& other, const Allocator& alloc) : HashMap(0, other.hash_, other.eq_, alloc) {
+        if (alloc_ == other.alloc_) swap_storage(other);
+        else move_elements_from(other);
+    }
+
+    /**
+     * @brief operator = - копирующий оператор присваивания
+     *
+     * Аллокатор other перенимается, только если propagate_on_container_copy_assignment.
+     */
+    HashMap& operator = (const HashMap& other) {
+        if (this != &other) {
+            constexpr bool propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+            HashMap temp(other, propagate ? other.alloc_ : alloc_);
+            swap_storage(temp);
+            if constexpr (propagate) swap_allocators(temp);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief operator = - перемещающий оператор присваивания
+     *
+     * Аллокатор other перенимается, только если propagate_on_container_move_assignment.
+     */
+    HashMap& operator = (HashMap&& other) {
+        if (this != &other) {
+            constexpr bool propagate = alloc_traits::propagate_on_container_move_assignment::value;
+
+            clear();
+            if constexpr (!propagate && !alloc_traits::is_always_equal::value) {
+                if (!(alloc_ == other.alloc_)) {
+                    move_elements_from(other);
+                    return *this;
+                }
+            }
+
+            swap_storage(other);
+            if constexpr (propagate) swap_allocators(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief swap - обмен содержимым двух HashMap
+     *
+     * Аллокаторы обмениваются, только если propagate_on_container_swap; иначе они должны быть равны.
+     */
+    void swap(HashMap& other) noexcept {
+        swap_storage(other);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) swap_allocators(other);
+    }
+
+    /**
+     * @brief size - количество элементов
+     */
+    std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief empty - Пуст ли контейнер?
+     */
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief get_allocator - копия аллокатора
+     */
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    /**
+     * @brief bucket_count - число слотов таблицы
+     */
+    std::size_t bucket_count() const noexcept { return capacity_; }
+
+    /**
+     * @brief load_factor - доля занятых слотов
+     */
+    float load_factor() const noexcept { return capacity_ == 0 ? 0.0f : float(size_) / float(capacity_); }
+
+    /**
+     * @brief max_load_factor - заполненность, после которой таблица перестраивается (фиксирована)
+     */
+    float max_load_factor() const noexcept { return 0.875f; }
+
+    /**
+     * @brief clear - очистка контейнера (память таблицы остается за ним)
+     */
+    void clear() noexcept {
+        if (capacity_ == 0) return;
+        destroy_elements();
+        std::memset(ctrl_, static_cast<unsigned char>(detail::ctrl_empty), capacity_ + group_width);
+        ctrl_[capacity_] = detail::ctrl_sentinel;
+        size_ = 0;
+        growth_left_ = capacity_to_growth(capacity_);
+    }
+
+    /**
+     * @brief reserve - подготовка к size элементам: до этого размера вставки не перестраивают таблицу
+     *
+     * @exception std::bad_alloc, исключения от конструктора копирования value_type (см. resize)
+     */
+    void reserve(std::size_t size) {
+        if (size > size_ + growth_left_) resize(capacity_for(size));
+    }
+
+    /**
+     * @brief rehash - перестроение таблицы с не менее чем count слотами
+     *
+     * Удаленные слоты при этом исчезают. rehash(0) пустой таблицы освобождает память.
+     *
+     * @exception std::bad_alloc, исключения от конструктора копирования value_type (см. resize)
+     */
+    void rehash(std::size_t count) {
+        if (count == 0 && size_ == 0) {
+            destroy_elements();
+            deallocate_storage(ctrl_, slots_, capacity_);
+            reset_empty();
+            return;
+        }
+        std::size_t capacity = std::max(capacity_for(size_), count == 0 ? 0 : std::bit_ceil(count + 1) - 1);
+        resize(std::max(capacity, min_capacity));
+    }
+
+private:
+
+    /**
+     * @brief swap_storage - обмен таблицами, хеш-функциями и сравнениями (без аллокаторов)
+     */
+    void swap_storage(HashMap& other) noexcept {
+        using std::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(growth_left_, other.growth_left_);
+        swap(hash_, other.hash_);
+        swap(eq_, other.eq_);
+    }
+
+    /**
+     * @brief swap_allocators - обмен аллокаторами
+     */
+    void swap_allocators(HashMap& other) noexcept {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        swap(ctrl_alloc_, other.ctrl_alloc_);
+    }
+
+    /**
+     * @brief move_elements_from - поэлементно перемещает элементы other (при неравных аллокаторах)
+     *
+     * @exception Любые исключения от конструктора перемещения Key, T
+     */
+    void move_elements_from(HashMap& other) {
+        reserve(other.size_);
+        for (auto& kv : other) emplace(std::move(kv));
+        other.clear();
+    }
+
+    //FINDER BLOCK
+
+    // Гетерогенный поиск - если и хеш-функция, и сравнение прозрачны (см. detail::transparent_key)
+    template<typename K>
+    static constexpr bool transparent_key =
+        detail::transparent_key<K, std::tuple<Hash, KeyEqual>, iterator, const_iterator>;
+
+    /**
+     * @brief finder - номер слота с ключом key или capacity_
+     *
+     * @param key - ключ
+     * @param hash - hash_of(key)
+     */
+    template<typename K>
+    std::size_t finder(const K& key, std::uint64_t hash) const {
+        ProbeSequence seq(h1(hash), capacity_);
+        while (true) {
+            Group group(ctrl_ + seq.offset);
+            for (std::uint32_t mask = group.match(h2(hash)); mask != 0; mask &= mask - 1) {
+                std::size_t i = seq.slot(std::countr_zero(mask));
+                if (eq_(slots_[i].first, key)) return i;
+            }
+            if (group.match_empty() != 0) return capacity_;
+            seq.next();
+        }
+    }
+
+    template<typename K>
+    std::size_t finder(const K& key) const { return finder(key, hash_of(key)); }
+
+public:
+
+    /**
+     * @brief find - поиск по ключу
+     *
+     * @return iterator на элемент или end()
+     */
+    iterator find(const Key& key) {
+        std::size_t i = finder(key);
+        return iterator(ctrl_ + i, slots_ + i);
+    }
+
+    const_iterator find(const Key& key) const {
+        std::size_t i = finder(key);
+        return const_iterator(ctrl_ + i, slots_ + i);
+    }
+
+    /**
+     * @brief find - гетерогенный поиск (только для прозрачных хеш-функции и сравнения)
+     */
+    template<typename K>
+    requires transparent_key<K>
+    iterator find(const K& key) {
+        std::size_t i = finder(key);
+        return iterator(ctrl_ + i, slots_ + i);
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator find(const K& key) const {
+        std::size_t i = finder(key);
+        return const_iterator(ctrl_ + i, slots_ + i);
+    }
+
+    /**
+     * @brief contains - проверяет есть ли ключ в таблице
+     */
+    bool contains(const Key& key) const { return finder(key) != capacity_; }
+
+    template<typename K>
+    requires transparent_key<K>
+    bool contains(const K& key) const { return finder(key) != capacity_; }
+
+    /**
+     * @brief count - количество элементов с ключом key (0 или 1)
+     */
+    std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    /**
+     * @brief at - доступ по ключу(бросает исключение)
+     *
+     * @exception std::out_of_range в случае, если HashMap не содержит key
+     */
+    T& at(const Key& key) {
+        std::size_t i = finder(key);
+        if (i == capacity_) throw std::out_of_range("HashMap doesent contains such element");
+        return slots_[i].second;
+    }
+
+    const T& at(const Key& key) const {
+        std::size_t i = finder(key);
+        if (i == capacity_) throw std::out_of_range("HashMap doesent contains such element");
+        return slots_[i].second;
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    T& at(const K& key) {
+        std::size_t i = finder(key);
+        if (i == capacity_) throw std::out_of_range("HashMap doesent contains such element");
+        return slots_[i].second;
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    const T& at(const K& key) const {
+        std::size_t i = finder(key);
+        if (i == capacity_) throw std::out_of_range("HashMap doesent contains such element");
+        return slots_[i].second;
+    }
+
+    /**
+     * @brief operator [] - вставляет пару (key, T()), если key нет, иначе - возвращает значение по ключу
+     */
+    T& operator[](const Key& key)
+        requires std::default_initializable<T>
+    {
+        return try_emplace(key).first->second;
+    }
+
+    T& operator[](Key&& key)
+        requires std::default_initializable<T>
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    // EMPLACE BLOCK
+
+private:
+
+    /**
+     * @brief inserter - вставка элемента с ключом key, собранного из args, если ключа еще нет
+     *
+     * Элемент собирается до перестроения таблицы: args могут ссылаться на ее элементы.
+     * Если ключ уже есть, args не используются.
+     *
+     * @exception std::bad_alloc, исключения от хеш-функции, сравнения и конструктора value_type
+     */
+    template<typename... Args>
+    std::pair<iterator, bool> inserter(const Key& key, Args&&... args) {
+        std::uint64_t hash = hash_of(key);
+        std::size_t i = finder(key, hash);
+        if (i != capacity_) return { iterator(ctrl_ + i, slots_ + i), false };
+
+        i = free_slot(ctrl_, capacity_, hash);
+        if (growth_left_ == 0 && ctrl_[i] != detail::ctrl_deleted) {
+            detail::temporary_value<value_type, Allocator> value(alloc_, std::forward<Args>(args)...);
+            grow();
+            i = free_slot(ctrl_, capacity_, hash);
+            alloc_traits::construct(alloc_, slots_ + i, std::move(value.get()));
+        } else {
+            alloc_traits::construct(alloc_, slots_ + i, std::forward<Args>(args)...);
+        }
+
+        if (ctrl_[i] == detail::ctrl_empty) --growth_left_;
+        set_ctrl(ctrl_, capacity_, i, h2(hash));
+        ++size_;
+        return { iterator(ctrl_ + i, slots_ + i), true };
+    }
+
+public:
+
+    /**
+     * @brief emplace - сборка элемента из переданных параметров
+     *
+     * Для emplace(key, value) и emplace(pair) сначала выполняется поиск, и элемент собирается, только если ключа еще нет.
+     * Иначе элемент собирается во временном объекте, по ключу которого идет поиск.
+     *
+     * @return std::pair<iterator, bool> - итератор на элемент и bool (вставлен ли элемент)
+     *
+     * @exception Любые исключения от конструктора из Args...
+     */
+    template<class... Args>
+    requires std::constructible_from<value_type, Args...>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        if constexpr (detail::key_is_extractable<Key, Args...>()) {
+            return inserter(detail::extract_key<Key>(args...), std::forward<Args>(args)...);
+        } else {
+            detail::temporary_value<value_type, Allocator> value(alloc_, std::forward<Args>(args)...);
+            return inserter(value.get().first, std::move(value.get()));
+        }
+    }
+
+    /**
+     * @brief try_emplace - вставка элемента, собранного из args, если ключа еще нет
+     *
+     * @exception std::bad_alloc, исключения от конструктора копирования Key или конструктора T из Args...
+     */
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return inserter(key, std::piecewise_construct,
+                        std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief try_emplace - вставка элемента, собранного из args, если ключа еще нет
+     *
+     * @param key - ключ (перемещается, только если элемент вставлен)
+     */
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        return inserter(key, std::piecewise_construct,
+                        std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief insert_or_assign - вставка (key, obj) или присваивание obj существующему элементу
+     *
+     * @return std::pair<iterator, bool> - итератор на элемент и bool (true - вставлен, false - присвоен)
+     */
+    template<typename M>
+    requires std::constructible_from<T, M&&> && std::assignable_from<T&, M&&>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        auto it = find(key);
+        if (it != end()) {
+            it->second = std::forward<M>(obj);
+            return { it, false };
+        }
+        return inserter(key, key, std::forward<M>(obj));
+    }
+
+    template<typename M>
+    requires std::constructible_from<T, M&&> && std::assignable_from<T&, M&&>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+        auto it = find(key);
+        if (it != end()) {
+            it->second = std::forward<M>(obj);
+            return { it, false };
+        }
+        return inserter(key, std::move(key), std::forward<M>(obj));
+    }
+
+    /**
+     * @brief insert - вставка пары элементов
+     */
+    std::pair<iterator, bool> insert(const value_type& kv) { return emplace(kv); }
+
+    /**
+     * @brief insert - вставка пары элементов перемещением
+     */
+    std::pair<iterator, bool> insert(value_type&& kv) { return emplace(std::move(kv)); }
+
+    // ERASE BLOCK
+
+private:
+
+    /**
+     * @brief eraser - удаление элемента в слоте i
+     *
+     * Слот становится пустым, если ни одно окно из group_width байтов, содержащее его, не было
+     * заполнено целиком (тогда ни один поиск не мог пройти через него дальше). Иначе ставится
+     * метка удаления, чтобы не оборвать чужие цепочки пробирования.
+     */
+    void eraser(std::size_t i) noexcept {
+        alloc_traits::destroy(alloc_, slots_ + i);
+        --size_;
+
+        std::size_t before = (i - group_width) & capacity_;
+        std::uint32_t empty_after = Group(ctrl_ + i).match_empty();
+        std::uint32_t empty_before = Group(ctrl_ + before).match_empty();
+
+        bool was_never_full = empty_before != 0 && empty_after != 0 &&
+            static_cast<std::size_t>(std::countr_zero(empty_after) +
+                                     std::countl_zero(static_cast<std::uint16_t>(empty_before))) < group_width;
+
+        if (was_never_full) {
+            set_ctrl(ctrl_, capacity_, i, detail::ctrl_empty);
+            ++growth_left_;
+        } else {
+            set_ctrl(ctrl_, capacity_, i, detail::ctrl_deleted);
+        }
+    }
+
+public:
+
+    /**
+     * @brief erase - удаляет элемент, на который указывает итератор
+     *
+     * @return iterator на следующий элемент
+     */
+    iterator erase(const_iterator position) noexcept {
+        std::size_t i = static_cast<std::size_t>(position.ctrl_ - ctrl_);
+        eraser(i);
+        return iterator_at(i);
+    }
+
+    iterator erase(iterator position) noexcept { return erase(const_iterator(position)); }
+
+    /**
+     * @brief erase - удаляет элемент по ключу
+     *
+     * @return std::size_t - число удаленных элементов
+     */
+    std::size_t erase(const Key& key) {
+        std::size_t i = finder(key);
+        if (i == capacity_) return 0;
+        eraser(i);
+        return 1;
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t erase(const K& key) {
+        std::size_t i = finder(key);
+        if (i == capacity_) return 0;
+        eraser(i);
+        return 1;
+    }
+
+    // ETC BLOCK
+
+    /**
+     * @brief invariants_checker - проверка инвариантов таблицы
+     *
+     * @exception std::logic_error в случае, если таблица невалидна
+     */
+    void invariants_checker() const {
+        if (capacity_ == 0) {
+            if (size_ != 0 || growth_left_ != 0 || ctrl_ != detail::empty_group)
+                throw std::logic_error("Empty table has stale fields;");
+            return;
+        }
+        if (((capacity_ + 1) & capacity_) != 0 || capacity_ < min_capacity)
+            throw std::logic_error("Capacity is not 2^k - 1;");
+        if (ctrl_[capacity_] != detail::ctrl_sentinel) throw std::logic_error("Sentinel is missing;");
+
+        std::size_t full = 0, deleted = 0;
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (i < group_width - 1 && ctrl_[capacity_ + 1 + i] != ctrl_[i]) throw std::logic_error("Cloned control byte differs;");
+            if (ctrl_[i] == detail::ctrl_deleted) ++deleted;
+            if (ctrl_[i] < 0) continue;
+
+            ++full;
+            std::uint64_t hash = hash_of(slots_[i].first);
+            if (ctrl_[i] != h2(hash)) throw std::logic_error("Control byte does not match hash;");
+            if (finder(slots_[i].first, hash) != i) throw std::logic_error("Element is unreachable by probing;");
+        }
+        if (full != size_) throw std::logic_error("Size mismatch;");
+        if (growth_left_ + size_ + deleted != capacity_to_growth(capacity_)) throw std::logic_error("Growth counter mismatch;");
+    }
+};
+
+} // namespace mystl
+
+#endif // HASHMAP_HPP
@@ -1,34 +1,160 @@
 #ifndef MAP_HPP
 #define MAP_HPP
 
+#include <bit>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
 #include <stdexcept>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
-// CURRENT VERSION v0.1.2
+#include "SlabAllocator.hpp"
+#include "MapTraits.hpp"
+
+// CURRENT VERSION v0.1.19
 
 // CHANGELOG:
 // > Добавлена безопастность исключений в конструкторы
 // > Добавлен метод swap()
+// > Исправлена балансировка после удаления (случаи 3-4 для левого ребенка)
+// > Учитываются propagate_on_container_* и аллокаторы с состоянием (ArenaAllocator, PoolAllocator);
+//   конструкторы копирования и перемещения с заданным аллокатором; get_allocator()
+// > Исправлен размер Map после перемещения из нее
+// > Псевдоним SlabMap - узлы в собственном пуле контейнера (SlabAllocator.hpp)
+// > Мнимая нода хранит самый левый и самый правый узлы: begin(), rbegin() и --end() за O(1)
+// > try_emplace(), insert_or_assign(); emplace(key, value), emplace(pair) и operator[]
+//   сначала ищут ключ и создают узел только для нового ключа
+// > lower_bound(), upper_bound(), equal_range(), count() и range(lo, hi) за O(log n)
+// > Гетерогенный поиск для прозрачного компаратора (Compare::is_transparent, например std::less<>):
+//   find(), contains(), count(), at(), erase(), lower_bound(), upper_bound(), equal_range(), range()
+// > emplace_hint() и insert(hint, value): если ключ встает рядом с подсказкой, спуск от корня не нужен.
+//   Конструкторы от диапазона вставляют с подсказкой end(), поэтому отсортированный вход собирается
+//   за O(1) сравнений на элемент
+// > Map(sorted_unique, first, last) и assign_sorted(first, last): сборка идеально сбалансированного
+//   дерева из отсортированного диапазона без повторов за O(n) без сравнений и поворотов
+// > cleaner() итеративный (обход по указателям на родителя, O(1) доп. памяти);
+//   cleaner() больше не переписывает связи удаляемых узлов; cloner() без рекурсии и не теряет узлы при исключении
+// > Дескрипторы узлов (node_type): extract(), insert(node_type&&), insert(hint, node_type&&) и merge()
+//   переносят узлы между Map без выделения памяти и без копирования/перемещения элементов
+// > split(key), join(left, right) и теоретико-множественные операции union_with(), intersect_with(),
+//   difference_with() на основе join/split КЧ-деревьев: O(m log(n/m + 1)) вместо поэлементных вставок
+// > Политика дополнения order_statistics (псевдоним OrderStatisticsMap): узлы хранят размеры поддеревьев,
+//   доступны nth(k), rank(key), index_of(it) и distance(first, last) за O(log n)
+// > Раскладка узлов compact_nodes (псевдоним CompactMap): цвет хранится в младшем бите указателя
+//   на родителя, узел на 8 байт меньше. Доступ к родителю и цвету - через parent()/set_parent(), is_red()/set_red()
+// > Исправлены merge() и insert(node_type&&) для Map с неравными аллокаторами (разные пулы SlabMap):
+//   узел чужого аллокатора не перевешивается, элемент перемещается в новый узел
+// > Исправлены join(), union_with(), intersect_with() и difference_with() для неравных аллокаторов:
+//   элементы перемещаются в новые узлы или ключи обрабатываются поштучно вместо перевешивания узлов
+// > rank() принимает ключи другого типа при прозрачном компараторе
 
 namespace mystl {
 
+/**
+ * @brief sorted_unique - тег для Map(sorted_unique, first, last): диапазон уже отсортирован
+ *        по компаратору и не содержит равных ключей
+ */
+struct sorted_unique_t { explicit sorted_unique_t() = default; };
+inline constexpr sorted_unique_t sorted_unique{};
+
+/**
+ * @brief no_augmentation - политика дополнения Map по умолчанию: узлы не хранят ничего лишнего
+ */
+struct no_augmentation {};
+
+/**
+ * @brief order_statistics - политика дополнения Map: каждый узел хранит размер своего поддерева
+ *
+ * Дает nth(), rank(), index_of() и distance() за O(log n) ценой одного size_t в узле
+ * и O(log n) дополнительных записей на вставку и удаление.
+ */
+struct order_statistics {};
+
+/**
+ * @brief wide_nodes - раскладка узлов Map по умолчанию: цвет хранится отдельным bool
+ */
+struct wide_nodes {};
+
+/**
+ * @brief compact_nodes - раскладка узлов Map, где цвет хранится в младшем бите указателя на родителя
+ *
+ * Узлы выровнены хотя бы по 2 байта, поэтому младший бит адреса всегда 0. Служебная часть узла
+ * уменьшается с 32 до 24 байт (на 64-битной платформе), цена - маскирование при переходе к родителю.
+ */
+struct compact_nodes {};
+
 template<
-    typename Key,//         -----------  ПОДМЕНА АЛЛОКАТОРА И КОМПАРАТОРА НЕ ТЕСТИРОВАЛАСЬ
+    typename Key,//         -----------  ПОДМЕНА КОМПАРАТОРА НЕ ТЕСТИРОВАЛАСЬ
     typename T,  //        \|/                         /
     typename Compare = std::less<Key>,  //           |/_
-    typename Allocator = std::allocator<std::pair<const Key, T>>
+    typename Allocator = std::allocator<std::pair<const Key, T>>,
+    typename Augmentation = no_augmentation,
+    typename NodeLayout = wide_nodes
     >
 class Map {
+public:
+
+    using allocator_type = Allocator;
+
 private:
 
     using value_type = std::pair<const Key, T>;
 
+    static constexpr bool counts_subtrees = std::is_same_v<Augmentation, order_statistics>;
+
+    struct NoCount {};
+    using SubtreeCount = std::conditional_t<counts_subtrees, std::size_t, NoCount>;
+
     // Фиктивная нода, обеспечивающая работу итератора
-    struct BaseNode {
-        BaseNode* left_ = nullptr;
-        BaseNode* right_ = nullptr;
+    struct BaseNode;
+
+    // Родитель и цвет узла: отдельными полями (wide_nodes)
+    struct WideLinks {
         BaseNode* parent_ = nullptr;
         bool is_red_ = false;
+
+        BaseNode* parent() const noexcept { return parent_; }
+        void set_parent(BaseNode* parent) noexcept { parent_ = parent; }
+
+        bool is_red() const noexcept { return is_red_; }
+        void set_red(bool red) noexcept { is_red_ = red; }
+    };
+
+    // Родитель и цвет узла в одном слове: младший бит - цвет (compact_nodes)
+    struct CompactLinks {
+        std::uintptr_t parent_and_color_ = 0;
+
+        static constexpr std::uintptr_t red_bit = 1;
+
+        BaseNode* parent() const noexcept { return reinterpret_cast<BaseNode*>(parent_and_color_ & ~red_bit); }
+        void set_parent(BaseNode* parent) noexcept {
+            parent_and_color_ = reinterpret_cast<std::uintptr_t>(parent) | (parent_and_color_ & red_bit);
+        }
+
+        bool is_red() const noexcept { return (parent_and_color_ & red_bit) != 0; }
+        void set_red(bool red) noexcept { parent_and_color_ = (parent_and_color_ & ~red_bit) | (red ? red_bit : 0); }
+    };
+
+    static constexpr bool compact_links = std::is_same_v<NodeLayout, compact_nodes>;
+
+    struct BaseNode : std::conditional_t<compact_links, CompactLinks, WideLinks> {
+        BaseNode* left_ = nullptr;
+        BaseNode* right_ = nullptr;
+        [[no_unique_address]] SubtreeCount count_{};  // размер поддерева (только для order_statistics)
+    };
+
+    static_assert(!compact_links || alignof(BaseNode) >= 2, "compact_nodes needs the low bit of node addresses");
+
+    // Мнимая нода. Помимо ссылки на корень хранит крайние узлы дерева
+    // (в пустом дереве оба указывают на саму мнимую ноду)
+    struct HeaderNode : BaseNode {
+        BaseNode* leftmost_ = nullptr;   // .begin()
+        BaseNode* rightmost_ = nullptr;  // --.end()
     };
 
     // Узел дерева
@@ -44,7 +170,7 @@ private:
 
     // TODO: При необходимости рефакторинга для noexcept конструкторов
     // рассмотреть хранение imaginary_ как члена класса (не указателя)
-    BaseNode* imaginary_;
+    HeaderNode* imaginary_;
 
     // По стандарту нужен размер
     std::size_t size_;
@@ -53,12 +179,14 @@ private:
     Compare comp_;
     Allocator alloc_;
 
+    using alloc_traits = std::allocator_traits<Allocator>;
+
     // Аллокатор для обычных узлов
     using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
     node_allocator node_alloc_;
 
     // Аллокатор для фиктивных узлов
-    using base_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<BaseNode>;
+    using base_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<HeaderNode>;
     base_allocator base_alloc_;
 
     //                   ~~Схема реализации~~
@@ -67,8 +195,8 @@ private:
     // |    это неважно    |
     //  ----------|--------   ______
     //            ↓          /    |/_ <--- цикл
-    //          [черный]imaginary(BaseNode) <--- .end() итератор
-    //                  /             \
+    //          [черный]imaginary(HeaderNode) <--- .end() итератор
+    //                  /             \        (+ leftmost_ и rightmost_)
     // [must be black] /             [черный]
     //           ↓    /              nullptr <--- (тут всегда nullptr)
     //         [черный]root(Node)                  \
@@ -89,13 +217,14 @@ private:
     class common_iterator {
     private:
 
-        using ConditionalPtr = std::conditional_t<IsConst, const value_type*, value_type*>;
-        using ConditionalRef = std::conditional_t<IsConst, const value_type&, value_type&>;
-        using ConditionalType = std::conditional_t<IsConst, const value_type, value_type>;
+        using ConditionalPtr = std::conditional_t<IsConst, const typename Map::value_type*, typename Map::value_type*>;
+        using ConditionalRef = std::conditional_t<IsConst, const typename Map::value_type&, typename Map::value_type&>;
+        using ConditionalType = std::conditional_t<IsConst, const typename Map::value_type, typename Map::value_type>;
 
         //Внутренняя структора итератора задается указателями на узел дерева, а не указателями на value_type
         using ConditionalBaseNodePtr = std::conditional_t<IsConst, const BaseNode*, BaseNode*>;
         using ConditionalNodePtr = std::conditional_t<IsConst, const Node*, Node*>;
+        using ConditionalHeaderPtr = std::conditional_t<IsConst, const HeaderNode*, HeaderNode*>;
 
         ConditionalBaseNodePtr node_ptr_;
 
@@ -113,7 +242,7 @@ private:
          * @param other - неконстантный итератор
          */
         common_iterator(const common_iterator<false>& other) noexcept
-            requires IsConst : node_ptr_(other.node_ptr_) {}
+            requires IsConst : node_ptr_(other.base()) {}
 
         /**
          * @brief Дефолт конструктор
@@ -166,7 +295,7 @@ private:
          */
         template <bool OtherConst>
         bool operator == (const common_iterator<OtherConst>& other) const noexcept
-        { return node_ptr_ == other.node_ptr_; }
+        { return node_ptr_ == other.base(); }
 
         /**
          * @brief operator !=
@@ -177,7 +306,7 @@ private:
          */
         template <bool OtherConst>
         bool operator != (const common_iterator<OtherConst>& other) const noexcept
-        { return node_ptr_ != other.node_ptr_; }
+        { return node_ptr_ != other.base(); }
 
         /**
          * @brief operator ++ - префиксный инкремент (inorder обход)
@@ -190,10 +319,10 @@ private:
                 while (node_ptr_->left_ != nullptr) node_ptr_ = node_ptr_->left_;
             }
             else{
-                auto parent = node_ptr_->parent_;
+                auto parent = node_ptr_->parent();
                 while (parent != nullptr && node_ptr_ == parent->right_) {
                     node_ptr_ = parent;
-                    parent = parent->parent_;
+                    parent = parent->parent();
                 }
                 node_ptr_ = parent;
             }
@@ -217,15 +346,20 @@ private:
          * @return common_iterator&
          */
         common_iterator& operator -- () noexcept {
+            // Мнимая нода - единственная, чей родитель она сама: --end() сразу дает максимум
+            if(node_ptr_->parent() == node_ptr_) {
+                node_ptr_ = static_cast<ConditionalHeaderPtr>(node_ptr_)->rightmost_;
+                return *this;
+            }
             if(node_ptr_->left_ != nullptr) {
                 node_ptr_ = node_ptr_->left_;
                 while (node_ptr_->right_ != nullptr) node_ptr_ = node_ptr_->right_;
             }
             else {
-                auto parent = node_ptr_->parent_;
+                auto parent = node_ptr_->parent();
                 while (parent != nullptr && node_ptr_ == parent->left_) {
                     node_ptr_ = parent;
-                    parent = parent->parent_;
+                    parent = parent->parent();
                 }
                 node_ptr_ = parent;
             }
@@ -264,27 +398,13 @@ public:
      *
      * @return iterator - итератор на самый левый узел дерева
      */
-    iterator begin() noexcept {
-        if (size_ == 0) return end();
-        BaseNode* leftmost = imaginary_->left_;
-        while (leftmost->left_ != nullptr) {
-            leftmost = leftmost->left_;
-        }
-        return iterator(leftmost);
-    }
+    iterator begin() noexcept { return iterator(imaginary_->leftmost_); }
     /**
      * @brief begin - итератор на начало таблицы
      *
      * @return const_iterator - константный итератор на самый левый узел дерева
      */
-    const_iterator begin() const noexcept {
-        if (size_ == 0) return end();
-        const BaseNode* leftmost = imaginary_->left_;
-        while (leftmost->left_ != nullptr) {
-            leftmost = leftmost->left_;
-        }
-        return const_iterator(leftmost);
-    }
+    const_iterator begin() const noexcept { return const_iterator(imaginary_->leftmost_); }
     /**
      * @brief cbegin - строго константный итератор на начало таблицы
      *
@@ -365,15 +485,35 @@ private:
      *
      * @exception std::bad_alloc в случае ошибки выделения памяти
      *
-     * @return BaseNode* - указатель на созданную ноду
+     * @return HeaderNode* - указатель на созданную ноду
      */
-    BaseNode* create_imaginary() {
-        BaseNode* node = std::allocator_traits<base_allocator>::allocate(base_alloc_, 1);
+    HeaderNode* create_imaginary() {
+        HeaderNode* node = std::allocator_traits<base_allocator>::allocate(base_alloc_, 1);
         std::allocator_traits<base_allocator>::construct(base_alloc_, node);
-        node->parent_ = node;
+        node->set_parent(node);
+        node->leftmost_ = node;
+        node->rightmost_ = node;
         return node;
     }
 
+    /**
+     * @brief update_extremes - заново находит крайние узлы дерева (после клонирования)
+     */
+    void update_extremes() noexcept {
+        BaseNode* root = imaginary_->left_;
+        if (root == nullptr) {
+            imaginary_->leftmost_ = imaginary_;
+            imaginary_->rightmost_ = imaginary_;
+            return;
+        }
+        BaseNode* leftmost = root;
+        while (leftmost->left_ != nullptr) leftmost = leftmost->left_;
+        BaseNode* rightmost = root;
+        while (rightmost->right_ != nullptr) rightmost = rightmost->right_;
+        imaginary_->leftmost_ = leftmost;
+        imaginary_->rightmost_ = rightmost;
+    }
+
     /**
      * @brief destroy_imaginary - освободить память из под мнимой ноды
      *
@@ -410,50 +550,154 @@ private:
     }
 
     /**
-     * @brief cleaner - рекурсивная очистка дерева(Не очищает память imaginary_)
+     * @brief cleaner - итеративная очистка поддерева (Не очищает память imaginary_)
      *
-     * @param node - указатель на узел
+     * Узлы уничтожаются в обратном порядке (post-order) обходом по указателям на родителя:
+     * ни стека, ни рекурсии, ни записи в связи удаляемых узлов. Указатель на поддерево
+     * у его родителя не обнуляется - это делает вызывающий.
+     *
+     * @param node - корень поддерева (его parent() не читается, поэтому поддерево может быть не подвешено)
      */
     void cleaner(BaseNode* node) noexcept {
         if (node == nullptr || node == imaginary_) return;
 
-        cleaner(node->left_);
-        cleaner(node->right_);
+        // Первый узел post-order обхода поддерева: спуск, пока есть хоть один ребенок
+        auto first_leaf = [](BaseNode* cur) noexcept {
+            while (true) {
+                if (cur->left_ != nullptr) cur = cur->left_;
+                else if (cur->right_ != nullptr) cur = cur->right_;
+                else return cur;
+            }
+        };
+
+        BaseNode* cur = first_leaf(node);
+        while (true) {
+            // Следующий узел определяем до уничтожения текущего
+            BaseNode* next = nullptr;
+            if (cur != node) {
+                BaseNode* parent = cur->parent();
+                if (cur == parent->left_ && parent->right_ != nullptr) next = first_leaf(parent->right_);
+                else next = parent;
+            }
+
+            auto real = static_cast<Node*>(cur);
+            std::allocator_traits<node_allocator>::destroy(node_alloc_, real);
+            std::allocator_traits<node_allocator>::deallocate(node_alloc_, real, 1);
 
-        if (node->parent_) {
-            if (node->parent_->left_ == node)
-                node->parent_->left_ = nullptr;
-            else if (node->parent_->right_ == node)
-                node->parent_->right_ = nullptr;
+            if (next == nullptr) return;
+            cur = next;
         }
+    }
 
-        auto real = static_cast<Node*>(node);
-        std::allocator_traits<node_allocator>::destroy(node_alloc_, real);
-        std::allocator_traits<node_allocator>::deallocate(node_alloc_, real, 1);
+    /**
+     * @brief clone_node - копия одного узла (цвет и родитель, без детей)
+     *
+     * @exception Любые исключения от конструктора копирования Key, T
+     */
+    Node* clone_node(BaseNode* node, BaseNode* parent) {
+        Node* new_node = create_node(static_cast<Node*>(node)->value_);
+        new_node->set_red(node->is_red());
+        new_node->count_ = node->count_;
+        new_node->set_parent(parent);
+        return new_node;
     }
 
     /**
-     * @brief cloner - клонирование дерева(Не клонирует imaginary_)
+     * @brief cloner - итеративное клонирование дерева с сохранением формы (Не клонирует imaginary_)
+     *
+     * Обход в прямом порядке (pre-order): спуск по левым детям, отложенные правые поддеревья - на стеке
+     * фиксированного размера. Высота КЧ-дерева не больше 2 * log2(n + 1), то есть меньше 128 для любого
+     * size_t, поэтому стек не переполняется, а каждый исходный узел читается ровно один раз.
      *
      * @param node - указатель на клононируемое дерево
      * @param parent - указатель на родителя(для установления связей в новом дереве)
      *
      * @return Node* - указатель на склонированное дерево
      *
-     * @exception Любые исключения от конструктора копирования Key, T
+     * @exception Любые исключения от конструктора копирования Key, T. Уже созданные узлы при этом уничтожаются
      */
     Node* cloner(BaseNode* node, BaseNode* parent) {
         if (node == nullptr) return nullptr;
 
-        Node* real = static_cast<Node*>(node);
-        auto new_node = create_node(real->value_);
+        struct Pending {
+            BaseNode* src;     // правый ребенок исходного узла
+            BaseNode* parent;  // копия исходного узла
+        };
+        Pending stack[2 * std::numeric_limits<std::size_t>::digits];
+        std::size_t top = 0;
 
-        new_node->is_red_ = node->is_red_;
-        new_node->parent_ = parent;
-        new_node->left_ = cloner(node->left_, new_node);
-        new_node->right_ = cloner(node->right_, new_node);
+        Node* root = clone_node(node, parent);
+        try {
+            BaseNode* src = node;
+            BaseNode* dst = root;
+            while (true) {
+                if (src->right_ != nullptr) stack[top++] = { src->right_, dst };
+
+                if (src->left_ != nullptr) {
+                    dst->left_ = clone_node(src->left_, dst);
+                    src = src->left_;
+                    dst = dst->left_;
+                } else if (top != 0) {
+                    --top;
+                    src = stack[top].src;
+                    dst = stack[top].parent->right_ = clone_node(src, stack[top].parent);
+                } else {
+                    return root;
+                }
+            }
+        } catch (...) {
+            cleaner(root);
+            throw;
+        }
+    }
 
-        return new_node;
+    /**
+     * @brief builder - сборка идеально сбалансированного поддерева из n элементов отсортированного диапазона
+     *
+     * Узлы создаются в порядке обхода (in-order), поэтому соседние по ключу узлы выделяются подряд
+     * (с SlabAllocator/PoolAllocator - в соседних блоках памяти). Середина диапазона становится корнем,
+     * поэтому все листья (nullptr) лежат на глубине red_depth или red_depth + 1. Узлы на глубине
+     * red_depth красные, остальные черные: черная высота одинакова, и красные узлы не имеют детей.
+     *
+     * @param first - итератор на очередной элемент (сдвигается на n)
+     * @param n - размер поддерева
+     * @param depth - глубина корня поддерева
+     * @param red_depth - глубина неполного нижнего уровня
+     *
+     * @return BaseNode* - корень поддерева (его parent() == nullptr)
+     *
+     * @exception Любые исключения от конструктора Node. Уже созданные узлы поддерева при этом уничтожаются
+     */
+    template<typename ForwardIt>
+    BaseNode* builder(ForwardIt& first, std::size_t n, std::size_t depth, std::size_t red_depth) {
+        if (n == 0) return nullptr;
+
+        std::size_t left_n = (n - 1) / 2;
+        BaseNode* left = builder(first, left_n, depth + 1, red_depth);
+
+        Node* node;
+        try {
+            node = create_node(*first);
+        } catch (...) {
+            cleaner(left);
+            throw;
+        }
+        ++first;
+
+        node->set_red(depth == red_depth);
+        if constexpr (counts_subtrees) node->count_ = n;
+        node->left_ = left;
+        if (left != nullptr) left->set_parent(node);
+
+        try {
+            node->right_ = builder(first, n - 1 - left_n, depth + 1, red_depth);
+        } catch (...) {
+            cleaner(node);
+            throw;
+        }
+        if (node->right_ != nullptr) node->right_->set_parent(node);
+
+        return node;
     }
 
 public:
@@ -493,11 +737,7 @@ public:
         node_alloc_(alloc),
         base_alloc_(alloc)
     {
-        try {
-            imaginary_ = create_imaginary();
-        } catch(...) {
-            destroy_imaginary();
-        }
+        imaginary_ = create_imaginary();
     }
 
     /**
@@ -520,12 +760,8 @@ public:
     Map(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator()) :
         Map(comp, alloc)
     {
-        try {
-            for(auto it = first; it != last; ++it) emplace(*it);
-        } catch(...) {
-            clear();
-            destroy_imaginary();
-        }
+        // Конструктор делегирующий: при исключении деструктор сам освободит узлы
+        for(auto it = first; it != last; ++it) emplace_hint(end(), *it);
     }
 
     /**
@@ -551,13 +787,7 @@ public:
         const Allocator& alloc = Allocator())
         requires std::copy_constructible<std::pair<const Key, T>> : Map(comp, alloc)
     {
-        try {
-            for(auto v : init) emplace(v);
-        } catch(...) {
-            clear();
-            destroy_imaginary();
-            throw;
-        }
+        for(const auto& v : init) emplace_hint(end(), v);
     }
 
     /**
@@ -568,6 +798,22 @@ public:
      */
     Map(std::initializer_list<value_type> init, const Allocator& alloc) : Map(init, Compare(), alloc) {}
 
+    /**
+     * @brief Map - конструктор от отсортированного диапазона без повторов за O(n) (см. assign_sorted)
+     *
+     * @param first - итератор на начало диапазона
+     * @param last - итератор на конец диапазона
+     * @param comp - компаратор, по которому отсортирован диапазон
+     * @param alloc - аллокатор
+     */
+    template<typename InputIt>
+    requires std::constructible_from<std::pair<const Key, T>, std::iter_reference_t<InputIt>>
+    Map(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator()) :
+        Map(comp, alloc)
+    {
+        assign_sorted(first, last);
+    }
+
     /**
      * @brief Конструктор копирования
      *
@@ -578,23 +824,33 @@ public:
      * @exception Любые исключения от конструктора копирования Key, T
      */
     Map(const Map& other)
+        requires std::copy_constructible<std::pair<const Key, T>> :
+        Map(other, alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    /**
+     * @brief Конструктор копирования с заданным аллокатором
+     *
+     * @param other - другой mystl::Map
+     * @param alloc - аллокатор
+     *
+     * @exception Любые исключения от конструктора копирования аллокатора или компаратора
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора копирования Key, T
+     */
+    Map(const Map& other, const Allocator& alloc)
         requires std::copy_constructible<std::pair<const Key, T>> :
         imaginary_(nullptr),
         size_(other.size_),
         comp_(other.comp_),
-        alloc_(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc_)),
+        alloc_(alloc),
         node_alloc_(alloc_),
         base_alloc_(alloc_)
     {
-        try {
-            imaginary_ = create_imaginary();
-        } catch(...) {
-            destroy_imaginary();
-            throw;
-        }
+        imaginary_ = create_imaginary();
 
         try {
             imaginary_->left_ = cloner(other.imaginary_->left_, imaginary_);
+            update_extremes();
         } catch(...) {
             clear();
             destroy_imaginary();
@@ -605,40 +861,57 @@ public:
     /**
      * @brief Map - конструктор перемещения
      *
+     * Дерево забирается целиком, other остается пустой.
+     *
      * @param other - другой mystl::map
      *
      * @exception std::bad_alloc при неудачном выделении памяти
      * @exception Любые исключения, связанные с копированием аллокатора или компаратора
      */
     Map(Map&& other)
-        : imaginary_(other.imaginary_),
-        size_(other.size_),
-        comp_(std::move(other.comp_)),
+        : imaginary_(nullptr),
+        size_(0),
+        comp_(other.comp_),
         alloc_(std::move(other.alloc_)),
         node_alloc_(std::move(other.node_alloc_)),
         base_alloc_(std::move(other.base_alloc_))
     {
-        try {
-            imaginary_ = create_imaginary();
-        } catch(...) {
-            destroy_imaginary();
-            throw;
-        }
+        imaginary_ = create_imaginary();
+        swap_storage(other);
+    }
 
-        swap(other);
+    /**
+     * @brief Map - конструктор перемещения с заданным аллокатором
+     *
+     * Если alloc не равен аллокатору other, узлы other забрать нельзя,
+     * и элементы перемещаются в новые узлы поштучно.
+     *
+     * @param other - другой mystl::map
+     * @param alloc - аллокатор
+     *
+     * @exception std::bad_alloc при неудачном выделении памяти
+     * @exception Любые исключения от конструктора перемещения Key, T
+     */
+    Map(Map&& other, const Allocator& alloc) : Map(other.comp_, alloc) {
+        if (alloc_traits::is_always_equal::value || alloc_ == other.alloc_) swap_storage(other);
+        else move_elements_from(other);
     }
 
     /**
      * @brief operator = - копирующий опревтор присваивания
      *
+     * Аллокатор other перенимается, только если propagate_on_container_copy_assignment.
+     *
      * @param other - другой mystl::Map
      *
      * @return Map& - ссылка на себя
      */
     Map& operator = (const Map& other) {
         if (this != &other) {
-            Map temp(other);
-            *this = std::move(temp);
+            constexpr bool propagate = alloc_traits::propagate_on_container_copy_assignment::value;
+            Map temp(other, propagate ? other.alloc_ : alloc_);
+            swap_storage(temp);
+            if constexpr (propagate) swap_allocators(temp);
         }
         return *this;
     }
@@ -646,22 +919,82 @@ public:
     /**
      * @brief operator = - перемещающий оператор присваивания
      *
+     * Аллокатор other перенимается, только если propagate_on_container_move_assignment.
+     * Если аллокатор не распространяется и не равен нашему, узлы other забрать нельзя:
+     * элементы перемещаются в новые узлы поштучно.
+     *
      * @param other - другой mystl::Map
      *
      * @return Map& - ссылка на себя
      */
     Map& operator = (Map&& other) {
         if(this != &other) {
-            Map temp(std::move(other));
-            swap(temp);
+            constexpr bool propagate = alloc_traits::propagate_on_container_move_assignment::value;
+
+            clear();
+            if constexpr (!propagate && !alloc_traits::is_always_equal::value) {
+                if (alloc_ != other.alloc_) {
+                    move_elements_from(other);
+                    return *this;
+                }
+            }
+
+            swap_storage(other);
+            if constexpr (propagate) swap_allocators(other);
         }
         return *this;
     }
 
+private:
+
+    /**
+     * @brief swap_storage - обмен деревьями (без аллокаторов)
+     *
+     * @param other - другая Map
+     */
+    void swap_storage(Map& other) noexcept {
+        std::swap(imaginary_, other.imaginary_);
+        std::swap(size_, other.size_);
+        std::swap(comp_, other.comp_);
+    }
+
+    /**
+     * @brief swap_allocators - обмен аллокаторами
+     *
+     * @param other - другая Map
+     */
+    void swap_allocators(Map& other) noexcept {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        swap(node_alloc_, other.node_alloc_);
+        swap(base_alloc_, other.base_alloc_);
+    }
+
+    /**
+     * @brief move_elements_from - поштучное перемещение элементов other в пустую Map
+     *
+     * Нужно, когда аллокаторы не равны и узлы other нельзя забрать. other очищается.
+     *
+     * @param other - другая Map
+     *
+     * @exception std::bad_alloc при неудачном выделении памяти
+     * @exception Любые исключения от конструктора перемещения Key, T
+     */
+    void move_elements_from(Map& other) {
+        for (auto& kv : other) emplace(std::move(kv));
+        other.clear();
+    }
+
+public:
+
     // FINDER BLOCK
 
 private:
 
+    // Гетерогенный поиск для прозрачного компаратора (см. detail::transparent_key)
+    template<typename K>
+    static constexpr bool transparent_key = detail::transparent_key<K, std::tuple<Compare>, iterator, const_iterator>;
+
     struct FindResult {
         BaseNode* parent;   // куда вставлять
         bool is_left;       // слева или справа
@@ -671,11 +1004,12 @@ private:
     /**
      * @brief finder - поиск элемента в дереве
      *
-     * @param key - ключ
+     * @param key - ключ (или сравнимое с ним значение для прозрачного компаратора)
      *
      * @return FindResult
      */
-    FindResult finder(const Key& key) const noexcept {
+    template<typename K>
+    FindResult finder(const K& key) const noexcept {
         BaseNode* cur = imaginary_->left_;
         BaseNode* parent = imaginary_;
         bool is_left = true;
@@ -725,94 +1059,494 @@ public:
         else return end();
     }
 
-
-    // RED-BLACK TREE BLOCK
-
-private:
-
     /**
-     * @brief is_red - Узел красный?
+     * @brief find - гетерогенный поиск (только для прозрачного компаратора)
      *
-     * @param node
+     * @param key - значение, сравнимое с Key
      *
-     * @return true, если узел красный
+     * @return iterator на std::pair<const Key, T>
      */
-    bool is_red(BaseNode* node) const noexcept {
-        // nullptr считается черным узлом (листом)
-        return node != nullptr && node->is_red_;
+    template<typename K>
+    requires transparent_key<K>
+    iterator find(const K& key) noexcept {
+        auto [_, __, ptr] = finder(key);
+        if(ptr != nullptr) return iterator(ptr);
+        else return end();
     }
 
     /**
-     * @brief verify_subtree - рекурсивный обход поддерева с проверкой инвариантов КЧ-дерева
-     *
-     * @param node - корень поддерева
+     * @brief find - гетерогенный поиск (только для прозрачного компаратора)
      *
-     * @return int - черная высота
+     * @param key - значение, сравнимое с Key
      *
-     * @throws std::logic_error в случае, если КЧ-дерево невалидно
+     * @return const_iterator на const std::pair<const Key, T>
      */
-    int verify_subtree(BaseNode* node) const {
-        if (node == nullptr) return 1; // nullptr (лист) имеет черную высоту 1
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator find(const K& key) const noexcept {
+        const auto [_, __, ptr] = finder(key);
+        if(ptr != nullptr) return const_iterator(ptr);
+        else return end();
+    }
 
-        if (is_red(node) && (is_red(node->left_) || is_red(node->right_)))
-            throw std::logic_error("There are two red nodes in a row;");
+    // RANGE QUERY BLOCK
 
-        int left_black_height = verify_subtree(node->left_);
-        int right_black_height = verify_subtree(node->right_);
+private:
 
-        if (left_black_height != right_black_height) throw std::logic_error("Black height mismatch between subtrees;");
+    /**
+     * @brief bounder - спуск от корня к первому узлу, ключ которого не меньше (Upper == false)
+     *        или строго больше (Upper == true) key
+     *
+     * @param key - ключ
+     *
+     * @return BaseNode* - найденный узел или imaginary_, если такого нет
+     */
+    template<bool Upper, typename K>
+    BaseNode* bounder(const K& key) const noexcept {
+        BaseNode* cur = imaginary_->left_;
+        BaseNode* result = imaginary_;
 
-        return left_black_height + (is_red(node) ? 0 : 1);
+        while (cur != nullptr) {
+            const Key& node_key = static_cast<Node*>(cur)->value_.first;
+            // Для lower_bound идем влево, пока node_key >= key, для upper_bound - пока node_key > key
+            bool go_left = Upper ? comp_(key, node_key) : !comp_(node_key, key);
+            if (go_left) {
+                result = cur;
+                cur = cur->left_;
+            } else {
+                cur = cur->right_;
+            }
+        }
+        return result;
     }
 
 public:
 
     /**
-     * @brief invariants_checker - обход всего дерева с целью проверки инвариантов КЧ-дерева
+     * @brief lower_bound - первый элемент, ключ которого не меньше key
      *
-     * @exception std::logic_error в случае, если КЧ-дерево невалидно
+     * @param key - ключ
+     *
+     * @return iterator на найденный элемент или end()
      */
-    void invariants_checker() const {
-        if(is_red(imaginary_)) throw std::logic_error("Imaginary node must be black, but it is red now;");
-        if(is_red(imaginary_->left_)) throw std::logic_error("Root is not black;");
-
-        try {
-            verify_subtree(imaginary_->left_);
-        } catch (const std::logic_error& e) {
-            throw std::logic_error(std::string("RB-tree invariant violation: ") + e.what());
-        }
-    }
+    iterator lower_bound(const Key& key) noexcept { return iterator(bounder<false>(key)); }
 
-private:
+    /**
+     * @brief lower_bound - первый элемент, ключ которого не меньше key
+     *
+     * @param key - ключ
+     *
+     * @return const_iterator на найденный элемент или end()
+     */
+    const_iterator lower_bound(const Key& key) const noexcept { return const_iterator(bounder<false>(key)); }
 
     /**
-     * @brief rotate_left - левый поворот вокруг ноды x
+     * @brief upper_bound - первый элемент, ключ которого больше key
      *
-     * @param x
+     * @param key - ключ
+     *
+     * @return iterator на найденный элемент или end()
      */
-    void rotate_left(BaseNode* x) noexcept {
-        BaseNode* y = x->right_;  // 1. Фиксируем правого ребенка
+    iterator upper_bound(const Key& key) noexcept { return iterator(bounder<true>(key)); }
 
-        // 2. Перемещаем поддерево B
-        x->right_ = y->left_;
-        if (y->left_) {
-            y->left_->parent_ = x;
-        }
+    /**
+     * @brief upper_bound - первый элемент, ключ которого больше key
+     *
+     * @param key - ключ
+     *
+     * @return const_iterator на найденный элемент или end()
+     */
+    const_iterator upper_bound(const Key& key) const noexcept { return const_iterator(bounder<true>(key)); }
+
+    /**
+     * @brief equal_range - диапазон элементов с ключом key (пустой или из одного элемента)
+     *
+     * @param key - ключ
+     *
+     * @return std::pair<iterator, iterator> - [lower_bound(key), upper_bound(key))
+     */
+    std::pair<iterator, iterator> equal_range(const Key& key) noexcept {
+        auto [_, __, ptr] = finder(key);
+        if (ptr == nullptr) {
+            iterator it = lower_bound(key);
+            return { it, it };
+        }
+        iterator it(ptr);
+        return { it, std::next(it) };
+    }
+
+    /**
+     * @brief equal_range - диапазон элементов с ключом key (пустой или из одного элемента)
+     *
+     * @param key - ключ
+     *
+     * @return std::pair<const_iterator, const_iterator> - [lower_bound(key), upper_bound(key))
+     */
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const noexcept {
+        const auto [_, __, ptr] = finder(key);
+        if (ptr == nullptr) {
+            const_iterator it = lower_bound(key);
+            return { it, it };
+        }
+        const_iterator it(ptr);
+        return { it, std::next(it) };
+    }
+
+    /**
+     * @brief count - количество элементов с ключом key (0 или 1)
+     *
+     * @param key - ключ
+     *
+     * @return std::size_t
+     */
+    std::size_t count(const Key& key) const noexcept { return finder(key).existing != nullptr ? 1 : 0; }
+
+    /**
+     * @brief range - элементы с ключами из полуинтервала [lo, hi)
+     *
+     * Границы находятся за O(log n), обход k элементов - за O(k).
+     *
+     *     for (auto& [t, v] : series.range(t0, t1)) ...
+     *
+     * @param lo - нижняя граница (включительно)
+     * @param hi - верхняя граница (не включительно)
+     *
+     * @return std::ranges::subrange<iterator> (пустой, если hi <= lo)
+     */
+    std::ranges::subrange<iterator> range(const Key& lo, const Key& hi) noexcept {
+        if (!comp_(lo, hi)) return { end(), end() };
+        return { lower_bound(lo), lower_bound(hi) };
+    }
+
+    /**
+     * @brief range - элементы с ключами из полуинтервала [lo, hi)
+     *
+     * @param lo - нижняя граница (включительно)
+     * @param hi - верхняя граница (не включительно)
+     *
+     * @return std::ranges::subrange<const_iterator> (пустой, если hi <= lo)
+     */
+    std::ranges::subrange<const_iterator> range(const Key& lo, const Key& hi) const noexcept {
+        if (!comp_(lo, hi)) return { end(), end() };
+        return { lower_bound(lo), lower_bound(hi) };
+    }
+
+    // Гетерогенные версии (только для прозрачного компаратора), семантика та же
+
+    template<typename K>
+    requires transparent_key<K>
+    iterator lower_bound(const K& key) noexcept { return iterator(bounder<false>(key)); }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator lower_bound(const K& key) const noexcept { return const_iterator(bounder<false>(key)); }
+
+    template<typename K>
+    requires transparent_key<K>
+    iterator upper_bound(const K& key) noexcept { return iterator(bounder<true>(key)); }
+
+    template<typename K>
+    requires transparent_key<K>
+    const_iterator upper_bound(const K& key) const noexcept { return const_iterator(bounder<true>(key)); }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::pair<iterator, iterator> equal_range(const K& key) noexcept {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const noexcept {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t count(const K& key) const noexcept { return finder(key).existing != nullptr ? 1 : 0; }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::ranges::subrange<iterator> range(const K& lo, const K& hi) noexcept {
+        if (!comp_(lo, hi)) return { end(), end() };
+        return { lower_bound(lo), lower_bound(hi) };
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    std::ranges::subrange<const_iterator> range(const K& lo, const K& hi) const noexcept {
+        if (!comp_(lo, hi)) return { end(), end() };
+        return { lower_bound(lo), lower_bound(hi) };
+    }
+
+
+    // ORDER STATISTICS BLOCK (только для order_statistics)
+
+    /**
+     * @brief nth - k-й по порядку элемент (с нуля)
+     *
+     * @param k - номер элемента
+     *
+     * @return iterator на k-й элемент или end(), если k >= size()
+     */
+    iterator nth(std::size_t k) noexcept
+        requires counts_subtrees
+    {
+        return iterator(selector(k));
+    }
+
+    /**
+     * @brief nth - k-й по порядку элемент (с нуля)
+     *
+     * @param k - номер элемента
+     *
+     * @return const_iterator на k-й элемент или end(), если k >= size()
+     */
+    const_iterator nth(std::size_t k) const noexcept
+        requires counts_subtrees
+    {
+        return const_iterator(selector(k));
+    }
+
+    /**
+     * @brief rank - число элементов с ключами меньше key (номер lower_bound(key))
+     *
+     * @param key - ключ
+     *
+     * @return std::size_t
+     */
+    std::size_t rank(const Key& key) const noexcept
+        requires counts_subtrees
+    {
+        return ranker(key);
+    }
+
+    // Гетерогенная версия (только для прозрачного компаратора), семантика та же
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t rank(const K& key) const noexcept
+        requires counts_subtrees
+    {
+        return ranker(key);
+    }
+
+    /**
+     * @brief index_of - номер элемента, на который указывает итератор
+     *
+     * @param position - итератор (для end() возвращается size())
+     *
+     * @return std::size_t
+     */
+    std::size_t index_of(const_iterator position) const noexcept
+        requires counts_subtrees
+    {
+        const BaseNode* node = position.base();
+        if (node == imaginary_) return size_;
+
+        std::size_t result = subtree_size(node->left_);
+        for (; node->parent() != imaginary_; node = node->parent()) {
+            if (node == node->parent()->right_) result += subtree_size(node->parent()->left_) + 1;
+        }
+        return result;
+    }
+
+    /**
+     * @brief distance - расстояние между итераторами за O(log n) (std::distance - за O(n))
+     *
+     * @param first - итератор на начало
+     * @param last - итератор на конец
+     *
+     * @return std::ptrdiff_t - index_of(last) - index_of(first)
+     */
+    std::ptrdiff_t distance(const_iterator first, const_iterator last) const noexcept
+        requires counts_subtrees
+    {
+        return static_cast<std::ptrdiff_t>(index_of(last)) - static_cast<std::ptrdiff_t>(index_of(first));
+    }
+
+private:
+
+    /**
+     * @brief selector - спуск к k-му элементу по размерам поддеревьев
+     *
+     * @return BaseNode* - узел или мнимая нода, если k >= size()
+     */
+    BaseNode* selector(std::size_t k) const noexcept
+        requires counts_subtrees
+    {
+        if (k >= size_) return imaginary_;
+
+        BaseNode* cur = imaginary_->left_;
+        while (true) {
+            std::size_t left = subtree_size(cur->left_);
+            if (k < left) {
+                cur = cur->left_;
+            } else if (k == left) {
+                return cur;
+            } else {
+                k -= left + 1;
+                cur = cur->right_;
+            }
+        }
+    }
+
+    /**
+     * @brief ranker - спуск к lower_bound(key) с подсчетом элементов левее
+     *
+     * @return std::size_t - число элементов с ключами меньше key
+     */
+    template<typename K>
+    std::size_t ranker(const K& key) const noexcept
+        requires counts_subtrees
+    {
+        std::size_t result = 0;
+        BaseNode* cur = imaginary_->left_;
+        while (cur != nullptr) {
+            if (comp_(static_cast<Node*>(cur)->value_.first, key)) {
+                result += subtree_size(cur->left_) + 1;
+                cur = cur->right_;
+            } else {
+                cur = cur->left_;
+            }
+        }
+        return result;
+    }
+
+    // RED-BLACK TREE BLOCK
+
+private:
+
+    /**
+     * @brief is_red - Узел красный?
+     *
+     * @param node
+     *
+     * @return true, если узел красный
+     */
+    bool is_red(BaseNode* node) const noexcept {
+        // nullptr считается черным узлом (листом)
+        return node != nullptr && node->is_red();
+    }
+
+    /**
+     * @brief verify_subtree - рекурсивный обход поддерева с проверкой инвариантов КЧ-дерева
+     *
+     * @param node - корень поддерева
+     *
+     * @return int - черная высота
+     *
+     * @throws std::logic_error в случае, если КЧ-дерево невалидно
+     */
+    int verify_subtree(BaseNode* node) const {
+        if (node == nullptr) return 1; // nullptr (лист) имеет черную высоту 1
+
+        if (is_red(node) && (is_red(node->left_) || is_red(node->right_)))
+            throw std::logic_error("There are two red nodes in a row;");
+
+        if constexpr (counts_subtrees) {
+            if (node->count_ != 1 + subtree_size(node->left_) + subtree_size(node->right_))
+                throw std::logic_error("Subtree size mismatch;");
+        }
+
+        int left_black_height = verify_subtree(node->left_);
+        int right_black_height = verify_subtree(node->right_);
+
+        if (left_black_height != right_black_height) throw std::logic_error("Black height mismatch between subtrees;");
+
+        return left_black_height + (is_red(node) ? 0 : 1);
+    }
+
+public:
+
+    /**
+     * @brief invariants_checker - обход всего дерева с целью проверки инвариантов КЧ-дерева
+     *
+     * @exception std::logic_error в случае, если КЧ-дерево невалидно
+     */
+    void invariants_checker() const {
+        if(is_red(imaginary_)) throw std::logic_error("Imaginary node must be black, but it is red now;");
+        if(is_red(imaginary_->left_)) throw std::logic_error("Root is not black;");
+
+        BaseNode* leftmost = imaginary_;
+        BaseNode* rightmost = imaginary_;
+        if (imaginary_->left_ != nullptr) {
+            leftmost = rightmost = imaginary_->left_;
+            while (leftmost->left_ != nullptr) leftmost = leftmost->left_;
+            while (rightmost->right_ != nullptr) rightmost = rightmost->right_;
+        }
+        if (leftmost != imaginary_->leftmost_ || rightmost != imaginary_->rightmost_)
+            throw std::logic_error("Cached leftmost/rightmost nodes are stale;");
+
+        try {
+            verify_subtree(imaginary_->left_);
+        } catch (const std::logic_error& e) {
+            throw std::logic_error(std::string("RB-tree invariant violation: ") + e.what());
+        }
+    }
+
+private:
+
+    /**
+     * @brief subtree_size - размер поддерева (только для order_statistics)
+     */
+    static std::size_t subtree_size(const BaseNode* node) noexcept
+        requires counts_subtrees
+    {
+        return node != nullptr ? node->count_ : 0;
+    }
+
+    /**
+     * @brief recount - пересчитывает размер поддерева node по детям (только для order_statistics)
+     */
+    static void recount(BaseNode* node) noexcept
+        requires counts_subtrees
+    {
+        node->count_ = 1 + subtree_size(node->left_) + subtree_size(node->right_);
+    }
+
+    /**
+     * @brief add_to_ancestors - прибавляет delta к размерам поддеревьев от node до корня (только для order_statistics)
+     */
+    void add_to_ancestors(BaseNode* node, std::size_t delta) noexcept
+        requires counts_subtrees
+    {
+        for (; node != imaginary_; node = node->parent()) node->count_ += delta;
+    }
+
+    /**
+     * @brief rotate_left - левый поворот вокруг ноды x
+     *
+     * @param x
+     */
+    void rotate_left(BaseNode* x) noexcept {
+        BaseNode* y = x->right_;  // 1. Фиксируем правого ребенка
+
+        // 2. Перемещаем поддерево B
+        x->right_ = y->left_;
+        if (y->left_) {
+            y->left_->set_parent(x);
+        }
 
         // 3. Устанавливаем родителя Y
-        y->parent_ = x->parent_;
-        if (x->parent_ == imaginary_) {
+        y->set_parent(x->parent());
+        if (x->parent() == imaginary_) {
             // X был корнем
             imaginary_->left_ = y;
-        } else if (x == x->parent_->left_) {
-            x->parent_->left_ = y;
+        } else if (x == x->parent()->left_) {
+            x->parent()->left_ = y;
         } else {
-            x->parent_->right_ = y;
+            x->parent()->right_ = y;
         }
 
         // 4. Делаем X левым ребенком Y
         y->left_ = x;
-        x->parent_ = y;
+        x->set_parent(y);
+
+        // 5. Y занял место X целиком, X потерял Y и его правое поддерево
+        if constexpr (counts_subtrees) {
+            y->count_ = x->count_;
+            recount(x);
+        }
     }
 
     /**
@@ -826,23 +1560,29 @@ private:
         // 2. Перемещаем поддерево B
         x->left_ = y->right_;
         if (y->right_) {
-            y->right_->parent_ = x;
+            y->right_->set_parent(x);
         }
 
         // 3. Устанавливаем родителя Y
-        y->parent_ = x->parent_;
-        if (x->parent_ == imaginary_) {
+        y->set_parent(x->parent());
+        if (x->parent() == imaginary_) {
             // X был корнем
             imaginary_->left_ = y;
-        } else if (x == x->parent_->left_) {
-            x->parent_->left_ = y;
+        } else if (x == x->parent()->left_) {
+            x->parent()->left_ = y;
         } else {
-            x->parent_->right_ = y;
+            x->parent()->right_ = y;
         }
 
         // 4. Делаем X правым ребенком Y
         y->right_ = x;
-        x->parent_ = y;
+        x->set_parent(y);
+
+        // 5. Y занял место X целиком, X потерял Y и его левое поддерево
+        if constexpr (counts_subtrees) {
+            y->count_ = x->count_;
+            recount(x);
+        }
     }
 
     // EMPLACE BLOCK
@@ -851,11 +1591,13 @@ private:
      * @brief emplace_balancer - валидирует КЧ-дерево при добавлении нового элемента
      *
      * @param node - указатель на вставленный узел
+     *
+     * @return true, если корень пришлось перекрасить в черный (черная высота дерева выросла)
      */
-    void emplace_balancer(BaseNode* node) noexcept {
-        while (node->parent_ != imaginary_ && is_red(node->parent_)) {
-            BaseNode* parent = node->parent_;
-            BaseNode* grandparent = parent->parent_;
+    bool emplace_balancer(BaseNode* node) noexcept {
+        while (node->parent() != imaginary_ && is_red(node->parent())) {
+            BaseNode* parent = node->parent();
+            BaseNode* grandparent = parent->parent();
             //            /|\
             //             |
             // Забавен тот факт, что условие цикла while НИКОГДА не
@@ -892,9 +1634,9 @@ private:
                     // [black]  [black]
                     // nullptr  nullptr
                     //                              |
-                    parent->is_red_ = false;     // |
-                    uncle->is_red_ = false;      // |
-                    grandparent->is_red_ = true; // |
+                    parent->set_red(false);     // |
+                    uncle->set_red(false);      // |
+                    grandparent->set_red(true); // |
                     node = grandparent;          // |
                     //                             \|/
                     //
@@ -940,7 +1682,7 @@ private:
                     //  nullptr  nullptr
                     //
                     node = parent;
-                    parent = node->parent_;
+                    parent = node->parent();
                 }
 
                 // Case 1.2.1:
@@ -957,8 +1699,8 @@ private:
                 // nullptr  nullptr             |
                 //                              |
                 rotate_right(grandparent);  //  |
-                parent->is_red_ = false;    //  |
-                grandparent->is_red_ = true;// \|/
+                parent->set_red(false);    //  |
+                grandparent->set_red(true);// \|/
                 //
                 //                             ...
                 //                           /    \
@@ -976,9 +1718,9 @@ private:
 
                 // Case 2.1: Дядя красный
                 if (is_red(uncle)) {
-                    parent->is_red_ = false;
-                    uncle->is_red_ = false;
-                    grandparent->is_red_ = true;
+                    parent->set_red(false);
+                    uncle->set_red(false);
+                    grandparent->set_red(true);
                     node = grandparent;
                     continue;
                 }
@@ -986,18 +1728,20 @@ private:
                 if (node == parent->left_) {
                     rotate_right(parent);
                     node = parent;
-                    parent = node->parent_;
+                    parent = node->parent();
                 }
 
                 // Case 2.2.1: Узел - правый ребенок
                 rotate_left(grandparent);
-                parent->is_red_ = false;
-                grandparent->is_red_ = true;
+                parent->set_red(false);
+                grandparent->set_red(true);
             }
         }
 
         // Красим корень в черный, соблюдая инвариант
-        if (imaginary_->left_) imaginary_->left_->is_red_ = false;
+        if (imaginary_->left_ == nullptr || !imaginary_->left_->is_red()) return false;
+        imaginary_->left_->set_red(false);
+        return true;
     }
 
 public:
@@ -1005,6 +1749,10 @@ public:
     /**
      * @brief emplace - сборка элемента из переданных параметров
      *
+     * Для emplace(key, value) и emplace(pair) ключ виден без сборки узла: сначала выполняется
+     * поиск, и узел создается, только если ключа еще нет. В остальных случаях (например,
+     * std::piecewise_construct) узел собирается заранее и уничтожается, если ключ уже есть.
+     *
      * @param args - кортеж параметров
      *
      * @return std::pair<iterator, bool> - итератор на собранный элемент и bool (вставлен ли элемент)
@@ -1014,55 +1762,315 @@ public:
     template< class... Args >
     requires std::constructible_from<std::pair<const Key, T>, Args...>
     std::pair<iterator, bool> emplace(Args&&... args) {
+        if constexpr (detail::key_is_extractable<Key, Args...>()) {
+            auto res = finder(detail::extract_key<Key>(args...));
+            if (res.existing != nullptr) return { iterator(res.existing), false };
 
-        auto new_node = create_node(std::forward<Args>(args)...);  // Прямая передача
-
-        auto res = finder(new_node->value_.first);
-
-        if (res.existing != nullptr) {
-            std::allocator_traits<node_allocator>::destroy(node_alloc_, new_node);
-            std::allocator_traits<node_allocator>::deallocate(node_alloc_, new_node, 1);
-            return { iterator(res.existing), false };
-        }
-
-        // Устанавливаем связь с родителем
-        if (res.is_left) res.parent->left_  = new_node;
-        else             res.parent->right_ = new_node;
-        new_node->parent_ = res.parent;
-
-        new_node->is_red_ = true;
+            return { link_node(res, create_node(std::forward<Args>(args)...)), true };
+        } else {
+            auto new_node = create_node(std::forward<Args>(args)...);  // Прямая передача
 
-        emplace_balancer(new_node);
+            auto res = finder(new_node->value_.first);
 
-        ++size_;
+            if (res.existing != nullptr) {
+                destroy_node(new_node);
+                return { iterator(res.existing), false };
+            }
 
-        return { iterator(new_node), true };
+            return { link_node(res, new_node), true };
+        }
     }
 
     /**
-     * @brief insert - вставка пары элементов
+     * @brief try_emplace - вставка элемента, собранного из args, если ключа еще нет
      *
-     * @param kv - пара const Key, T
+     * В отличие от emplace, при существующем ключе args не используются (не перемещаются).
      *
-     * @return std::pair<iterator, bool> - итератор на собранный элемент и bool (вставлен ли элемент)
+     * @param key - ключ
+     * @param args - аргументы конструктора T
      *
-     * @exception Любые исключения от конструктора копирования Key, T
+     * @return std::pair<iterator, bool> - итератор на элемент с ключом key и bool (вставлен ли элемент)
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора копирования Key или конструктора T из Args...
      */
-    std::pair<iterator, bool> insert(const std::pair<const Key, T>& kv) { return emplace(kv); }
-
-    // ERASE BLOCK
-
-private:
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return try_emplace_key(key, std::forward<Args>(args)...);
+    }
 
     /**
-     * @brief eraser - механизм удаления узла по указаьтелю
+     * @brief try_emplace - вставка элемента, собранного из args, если ключа еще нет
      *
-     * Удаляет узел из бинарного дерева поиска по классическому алгоритму и
-     * при необходимости вызывает балансировщик для поддержания инвариантов КЧ-дерева
+     * @param key - ключ (перемещается, только если элемент вставлен)
+     * @param args - аргументы конструктора T
      *
-     * @param node - указатель на удалемый узел
+     * @return std::pair<iterator, bool> - итератор на элемент с ключом key и bool (вставлен ли элемент)
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора перемещения Key или конструктора T из Args...
      */
-    void eraser(BaseNode* node) noexcept {
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        return try_emplace_key(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief insert_or_assign - вставка (key, obj) или присваивание obj существующему элементу
+     *
+     * @param key - ключ
+     * @param obj - значение
+     *
+     * @return std::pair<iterator, bool> - итератор на элемент и bool (true - вставлен, false - присвоен)
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора или оператора присваивания T
+     */
+    template<typename M>
+    requires std::constructible_from<T, M&&> && std::assignable_from<T&, M&&>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        return insert_or_assign_key(key, std::forward<M>(obj));
+    }
+
+    /**
+     * @brief insert_or_assign - вставка (key, obj) или присваивание obj существующему элементу
+     *
+     * @param key - ключ (перемещается, только если элемент вставлен)
+     * @param obj - значение
+     *
+     * @return std::pair<iterator, bool> - итератор на элемент и bool (true - вставлен, false - присвоен)
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора или оператора присваивания T
+     */
+    template<typename M>
+    requires std::constructible_from<T, M&&> && std::assignable_from<T&, M&&>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+        return insert_or_assign_key(std::move(key), std::forward<M>(obj));
+    }
+
+    /**
+     * @brief insert - вставка пары элементов
+     *
+     * @param kv - пара const Key, T
+     *
+     * @return std::pair<iterator, bool> - итератор на собранный элемент и bool (вставлен ли элемент)
+     *
+     * @exception Любые исключения от конструктора копирования Key, T
+     */
+    std::pair<iterator, bool> insert(const std::pair<const Key, T>& kv) { return emplace(kv); }
+
+    /**
+     * @brief insert - вставка пары элементов перемещением
+     *
+     * @param kv - пара const Key, T
+     *
+     * @return std::pair<iterator, bool> - итератор на собранный элемент и bool (вставлен ли элемент)
+     *
+     * @exception Любые исключения от конструктора копирования Key или перемещения T
+     */
+    std::pair<iterator, bool> insert(std::pair<const Key, T>&& kv) { return emplace(std::move(kv)); }
+
+    /**
+     * @brief emplace_hint - сборка элемента с подсказкой позиции
+     *
+     * Если ключ должен встать непосредственно перед или после hint (или hint указывает на равный ключ),
+     * вставка выполняется за O(1) сравнений (плюс амортизированно O(1) на балансировку),
+     * иначе - как обычный emplace. Вставка по возрастанию с hint = end() - линейная.
+     *
+     * @param hint - итератор на элемент, перед которым предполагается вставка
+     * @param args - кортеж параметров
+     *
+     * @return iterator - итератор на вставленный элемент или на элемент с таким же ключом
+     *
+     * @exception Любые исключения от конструктора из Args...
+     */
+    template< class... Args >
+    requires std::constructible_from<std::pair<const Key, T>, Args...>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        BaseNode* pos = const_cast<BaseNode*>(hint.base());
+
+        if constexpr (detail::key_is_extractable<Key, Args...>()) {
+            auto res = hint_finder(pos, detail::extract_key<Key>(args...));
+            if (res.existing != nullptr) return iterator(res.existing);
+
+            return link_node(res, create_node(std::forward<Args>(args)...));
+        } else {
+            auto new_node = create_node(std::forward<Args>(args)...);
+
+            auto res = hint_finder(pos, new_node->value_.first);
+
+            if (res.existing != nullptr) {
+                destroy_node(new_node);
+                return iterator(res.existing);
+            }
+
+            return link_node(res, new_node);
+        }
+    }
+
+    /**
+     * @brief insert - вставка пары элементов с подсказкой позиции (см. emplace_hint)
+     *
+     * @param hint - итератор на элемент, перед которым предполагается вставка
+     * @param kv - пара const Key, T
+     *
+     * @return iterator - итератор на вставленный элемент или на элемент с таким же ключом
+     *
+     * @exception Любые исключения от конструктора копирования Key, T
+     */
+    iterator insert(const_iterator hint, const std::pair<const Key, T>& kv) { return emplace_hint(hint, kv); }
+
+    /**
+     * @brief insert - вставка пары элементов перемещением с подсказкой позиции (см. emplace_hint)
+     *
+     * @param hint - итератор на элемент, перед которым предполагается вставка
+     * @param kv - пара const Key, T
+     *
+     * @return iterator - итератор на вставленный элемент или на элемент с таким же ключом
+     *
+     * @exception Любые исключения от конструктора копирования Key или перемещения T
+     */
+    iterator insert(const_iterator hint, std::pair<const Key, T>&& kv) { return emplace_hint(hint, std::move(kv)); }
+
+private:
+
+    /**
+     * @brief hint_finder - точка вставки key с учетом подсказки
+     *
+     * Проверяет, что key лежит строго между предшественником hint и hint (или между hint и его
+     * последователем). Тогда у одного из двух соседей нет нужного ребенка, и узел подвешивается
+     * туда без спуска от корня. При неверной подсказке вызывается обычный finder.
+     *
+     * @param hint - узел-подсказка (может быть мнимой нодой, т.е. end())
+     * @param key - ключ
+     *
+     * @return FindResult
+     */
+    FindResult hint_finder(BaseNode* hint, const Key& key) const noexcept {
+        if (size_ == 0) return { imaginary_, true, nullptr };
+
+        if (hint != imaginary_) {
+            Node* h = static_cast<Node*>(hint);
+            if (!comp_(key, h->value_.first)) {
+                if (!comp_(h->value_.first, key)) return { nullptr, false, h };  // равный ключ
+
+                // key > hint: симметрично проверяем последователя (подсказка - предыдущая вставка)
+                BaseNode* next = (++iterator(hint)).base();
+                if (next != imaginary_ && !comp_(key, static_cast<Node*>(next)->value_.first)) return finder(key);
+
+                if (hint->right_ == nullptr) return { hint, false, nullptr };
+                return { next, true, nullptr };
+            }
+        }
+
+        // key < hint (или hint == end()). Сравниваем с предшественником
+        if (hint == imaginary_->leftmost_) return { hint, true, nullptr };
+
+        BaseNode* prev = (--iterator(hint)).base();
+        Node* p = static_cast<Node*>(prev);
+        if (!comp_(p->value_.first, key)) return finder(key);
+
+        // prev < key < hint: prev и hint соседние, поэтому либо у hint нет левого ребенка,
+        // либо у prev нет правого
+        if (prev->right_ == nullptr) return { prev, false, nullptr };
+        return { hint, true, nullptr };
+    }
+
+    /**
+     * @brief link_node - подвешивает новый узел в точку вставки, найденную finder, и балансирует дерево
+     *
+     * @param res - результат finder для ключа нового узла (res.existing == nullptr)
+     * @param new_node - новый узел
+     *
+     * @return iterator на вставленный узел
+     */
+    iterator link_node(const FindResult& res, Node* new_node) noexcept {
+        // Устанавливаем связь с родителем
+        if (res.is_left) res.parent->left_  = new_node;
+        else             res.parent->right_ = new_node;
+        new_node->set_parent(res.parent);
+
+        // Новый минимум - только левый ребенок прежнего минимума, максимум - симметрично.
+        // В пустом дереве родитель - мнимая нода, и крайними становятся оба указателя
+        if (res.parent == imaginary_) {
+            imaginary_->leftmost_ = new_node;
+            imaginary_->rightmost_ = new_node;
+        } else if (res.is_left) {
+            if (res.parent == imaginary_->leftmost_) imaginary_->leftmost_ = new_node;
+        } else {
+            if (res.parent == imaginary_->rightmost_) imaginary_->rightmost_ = new_node;
+        }
+
+        new_node->set_red(true);
+
+        if constexpr (counts_subtrees) {
+            new_node->count_ = 1;
+            add_to_ancestors(res.parent, 1);
+        }
+
+        emplace_balancer(new_node);
+
+        ++size_;
+
+        return iterator(new_node);
+    }
+
+    /**
+     * @brief destroy_node - уничтожает узел, не подвешенный к дереву, и освобождает память
+     *
+     * @param node - указатель на узел
+     */
+    void destroy_node(Node* node) noexcept {
+        std::allocator_traits<node_allocator>::destroy(node_alloc_, node);
+        std::allocator_traits<node_allocator>::deallocate(node_alloc_, node, 1);
+    }
+
+    /**
+     * @brief try_emplace_key - общая реализация try_emplace для const Key& и Key&&
+     */
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace_key(K&& key, Args&&... args) {
+        auto res = finder(key);
+        if (res.existing != nullptr) return { iterator(res.existing), false };
+
+        Node* new_node = create_node(std::piecewise_construct,
+                                     std::forward_as_tuple(std::forward<K>(key)),
+                                     std::forward_as_tuple(std::forward<Args>(args)...));
+        return { link_node(res, new_node), true };
+    }
+
+    /**
+     * @brief insert_or_assign_key - общая реализация insert_or_assign для const Key& и Key&&
+     */
+    template<typename K, typename M>
+    std::pair<iterator, bool> insert_or_assign_key(K&& key, M&& obj) {
+        auto res = finder(key);
+        if (res.existing != nullptr) {
+            res.existing->value_.second = std::forward<M>(obj);
+            return { iterator(res.existing), false };
+        }
+
+        return { link_node(res, create_node(std::forward<K>(key), std::forward<M>(obj))), true };
+    }
+
+public:
+
+    // ERASE BLOCK
+
+private:
+
+    /**
+     * @brief unlinker - механизм отвязки узла от дерева по указателю (память узла не освобождается)
+     *
+     * Удаляет узел из бинарного дерева поиска по классическому алгоритму и
+     * при необходимости вызывает балансировщик для поддержания инвариантов КЧ-дерева
+     *
+     * @param node - указатель на удалемый узел
+     */
+    void unlinker(BaseNode* node) noexcept {
 
         BaseNode* node_for_balancing = nullptr;  // Узел, с которого начнется балансировка
         BaseNode* nfb_ancestor = nullptr;
@@ -1070,17 +2078,44 @@ private:
 
         bool original_color = is_red(node);  // Сохраняем оригинальный цвет
 
+        // Физически из дерева уходит node или (при двух детях) его преемник:
+        // все их предки теряют по одному элементу
+        if constexpr (counts_subtrees) {
+            BaseNode* removed = node;
+            if (node->left_ != nullptr && node->right_ != nullptr) {
+                removed = node->right_;
+                while (removed->left_ != nullptr) removed = removed->left_;
+            }
+            for (BaseNode* p = removed->parent(); p != imaginary_; p = p->parent()) --p->count_;
+        }
+
+        // Крайние узлы пересчитываем до перестройки связей. У минимума нет левого ребенка,
+        // поэтому его преемник - минимум правого поддерева или родитель (мнимая нода,
+        // если дерево опустеет). Для максимума симметрично
+        if (node == imaginary_->leftmost_) {
+            BaseNode* next = node->right_;
+            if (next != nullptr) while (next->left_ != nullptr) next = next->left_;
+            else next = node->parent();
+            imaginary_->leftmost_ = next;
+        }
+        if (node == imaginary_->rightmost_) {
+            BaseNode* prev = node->left_;
+            if (prev != nullptr) while (prev->right_ != nullptr) prev = prev->right_;
+            else prev = node->parent();
+            imaginary_->rightmost_ = prev;
+        }
+
         //
         // Случай 0: нет детей
         //
         if(node->right_ == nullptr && node->left_ == nullptr) {
 
             node_for_balancing = nullptr;
-            nfb_ancestor = node->parent_;
-            nfb_is_left = (node == node->parent_->left_);
+            nfb_ancestor = node->parent();
+            nfb_is_left = (node == node->parent()->left_);
 
-            if (node == node->parent_->left_) node->parent_->left_  = nullptr;
-            else                              node->parent_->right_ = nullptr;
+            if (node == node->parent()->left_) node->parent()->left_  = nullptr;
+            else                              node->parent()->right_ = nullptr;
 
         }
         //
@@ -1090,28 +2125,28 @@ private:
         else if (node->right_ != nullptr && node->left_ == nullptr) {
 
             node_for_balancing = node->right_;
-            nfb_ancestor = node->parent_;
-            nfb_is_left = (node == node->parent_->left_);
+            nfb_ancestor = node->parent();
+            nfb_is_left = (node == node->parent()->left_);
 
             // 1.1.1 Узел - левый потомок
-            if (node == node->parent_->left_) node->parent_->left_  = node_for_balancing;
+            if (node == node->parent()->left_) node->parent()->left_  = node_for_balancing;
             //1.1.2 Узел - правый потомок
-            else                              node->parent_->right_ = node_for_balancing;
+            else                              node->parent()->right_ = node_for_balancing;
 
             // Восстанавливаем связь с родителем
-            node_for_balancing->parent_ = node->parent_;
+            node_for_balancing->set_parent(node->parent());
 
         }
         // 1.2: Левый ребеной (симметрично 1.1)
         else if (node->right_ == nullptr && node->left_ != nullptr) {
             node_for_balancing = node->left_;
-            nfb_ancestor = node->parent_;
-            nfb_is_left = (node == node->parent_->left_);
+            nfb_ancestor = node->parent();
+            nfb_is_left = (node == node->parent()->left_);
 
-            if (node == node->parent_->left_) node->parent_->left_  = node_for_balancing;
-            else                              node->parent_->right_ = node_for_balancing;
+            if (node == node->parent()->left_) node->parent()->left_  = node_for_balancing;
+            else                              node->parent()->right_ = node_for_balancing;
 
-            node_for_balancing->parent_ = node->parent_;
+            node_for_balancing->set_parent(node->parent());
         }
         //
         // Cлучай 2: два ребенка
@@ -1141,7 +2176,7 @@ private:
             //
             if (replacement != node->right_) {
 
-                nfb_ancestor = replacement->parent_;
+                nfb_ancestor = replacement->parent();
                 nfb_is_left = true;
 
                 // Заменяем преемника его правым ребенком:
@@ -1156,14 +2191,14 @@ private:
                 //           ...    ...
                 //
 
-                replacement->parent_->left_ = replacement->right_;
+                replacement->parent()->left_ = replacement->right_;
 
                 // Восстановление связи с родителем
-                if (replacement->right_ != nullptr) replacement->right_->parent_ = replacement->parent_;
+                if (replacement->right_ != nullptr) replacement->right_->set_parent(replacement->parent());
 
                 // Присоединяем правое поддерево удаляемого узла к преемнику
                 replacement->right_ = node->right_;
-                node->right_->parent_ = replacement;
+                node->right_->set_parent(replacement);
 
             }
             // 2.2: Преемник является непосредственным правым ребенком удаляемого узла
@@ -1188,30 +2223,37 @@ private:
             //
 
             // 1. Определяем, был ли удаляемый узел левым или правым ребенком своего родителя
-            if (node == node->parent_->left_) node->parent_->left_  = replacement;
-            else                              node->parent_->right_ = replacement;
+            if (node == node->parent()->left_) node->parent()->left_  = replacement;
+            else                              node->parent()->right_ = replacement;
 
             // 2. Устанавливаем родителя преемника
-            replacement->parent_ = node->parent_;
+            replacement->set_parent(node->parent());
 
             // Присоединяем левое поддерево удаляемого узла к преемнику
             replacement->left_ = node->left_;
-            if(node->left_ != nullptr) node->left_->parent_ = replacement;
+            if(node->left_ != nullptr) node->left_->set_parent(replacement);
 
             // Копируем цвет удаляемого узла в преемника
-            replacement->is_red_ = is_red(node);
+            replacement->set_red(is_red(node));
+            if constexpr (counts_subtrees) replacement->count_ = node->count_;
         }
 
-        // Освобождаем память удаленного узла
-        Node* real = static_cast<Node*>(node);
-        std::allocator_traits<node_allocator>::destroy(node_alloc_, real);
-        std::allocator_traits<node_allocator>::deallocate(node_alloc_, real, 1);
         --size_;
 
         // Позвать балансировщика
         if (!original_color) erase_balancer(node_for_balancing, nfb_ancestor, nfb_is_left);
     }
 
+    /**
+     * @brief eraser - удаление узла по указателю: отвязка от дерева и освобождение памяти
+     *
+     * @param node - указатель на удалемый узел
+     */
+    void eraser(BaseNode* node) noexcept {
+        unlinker(node);
+        destroy_node(static_cast<Node*>(node));
+    }
+
     /**
      * @brief Балансировка дерева после удаления черного узла
      *
@@ -1221,7 +2263,7 @@ private:
         // Начальные локальные переменные: будем поддерживать parent отдельно,
         // потому что x может быть nullptr.
         BaseNode* node   = x;
-        BaseNode* parent = x ? x->parent_ : x_parent;
+        BaseNode* parent = x ? x->parent() : x_parent;
         bool is_left = x_is_left;
 
         // Цикл: пока x не корень и x чёрный
@@ -1252,8 +2294,8 @@ private:
                 //
                 if (is_red(brother)) {
                     // Перекраска
-                    brother->is_red_ = false;
-                    parent->is_red_ = true;
+                    brother->set_red(false);
+                    parent->set_red(true);
 
                     // Поворот влево вокруг parent
                     rotate_left(parent);
@@ -1290,10 +2332,10 @@ private:
                 //                ... ...  ... ...
                 //
                 if (!is_red(b_left) && !is_red(b_right)) {
-                    if (brother != nullptr) brother->is_red_ = true; // если brother == nullptr — ничего не делаем
+                    if (brother != nullptr) brother->set_red(true); // если brother == nullptr — ничего не делаем
                     // переносим проблему выше: node = parent
                     node = parent;
-                    parent = node->parent_;
+                    parent = node->parent();
                     is_left = (node == parent->left_);
                     continue; // продолжить цикл с новым node/parent
                 }
@@ -1335,12 +2377,12 @@ private:
                     if (!is_red(b_right)) {
                         // Здесь гарантированно b_left != nullptr && is_red(b_left) == true
                         // Сделаем перекраску и малый поворот вокруг brother
-                        b_left->is_red_ = false;
-                        brother->is_red_ = true;
+                        b_left->set_red(false);
+                        brother->set_red(true);
                         rotate_right(brother);
 
                         // Обновим локальные указатели после rotate_right
-                        parent  = node ? node->parent_ : x_parent;
+                        // (parent поворот не затрагивает, а node может быть nullptr)
                         brother = parent->right_;
                         b_right = brother ? brother->right_ : nullptr;
                         //b_left далее не задействован, персчет необязателен
@@ -1372,10 +2414,10 @@ private:
                     //
 
                     // Перекраска и левый поворот вокруг parent
-                    brother->is_red_ = is_red(parent);
+                    brother->set_red(is_red(parent));
 
-                    parent->is_red_  = false;
-                    b_right->is_red_ = false;
+                    parent->set_red(false);
+                    b_right->set_red(false);
 
                     rotate_left(parent);
 
@@ -1394,14 +2436,15 @@ private:
                     //      /   \
                     //    a...  b...
                     //
+                    break;
                 }
             } else {
                 // node - правый ребенок parent
                 BaseNode* brother = parent->left_;
 
                 if (is_red(brother)) {
-                    brother->is_red_ = false;
-                    parent->is_red_ = true;
+                    brother->set_red(false);
+                    parent->set_red(true);
                     rotate_right(parent);
 
                     brother = parent->left_;
@@ -1411,25 +2454,25 @@ private:
                 BaseNode* b_right = brother ? brother->right_ : nullptr;
 
                 if (!is_red(b_left) && !is_red(b_right)) {
-                    if (brother != nullptr) brother->is_red_ = true;
+                    if (brother != nullptr) brother->set_red(true);
                     node = parent;
-                    parent = node->parent_;
+                    parent = node->parent();
                     is_left = (node == parent->left_);
                     continue;
                 }
 
                 if (!is_red(b_left)) {
-                    if (b_right != nullptr) b_right->is_red_ = false;
-                    brother->is_red_ = true;
+                    if (b_right != nullptr) b_right->set_red(false);
+                    brother->set_red(true);
                     rotate_left(brother);
 
                     brother = parent->left_;
                     b_left = brother ? brother->left_ : nullptr;
                 }
 
-                brother->is_red_ = is_red(parent);
-                parent->is_red_ = false;
-                if (b_left != nullptr) b_left->is_red_ = false;
+                brother->set_red(is_red(parent));
+                parent->set_red(false);
+                if (b_left != nullptr) b_left->set_red(false);
 
                 rotate_right(parent);
                 node = imaginary_->left_;
@@ -1437,7 +2480,7 @@ private:
             }
         }
 
-        if (node != nullptr) node->is_red_ = false;  // Восстанавливает все свойства
+        if (node != nullptr) node->set_red(false);  // Восстанавливает все свойства
     }
 
 public:
@@ -1477,6 +2520,709 @@ public:
         }
     }
 
+    /**
+     * @brief erase - гетерогенное удаление по ключу (только для прозрачного компаратора)
+     *
+     * @param key - значение, сравнимое с Key
+     *
+     * @return std::size_t - количество удаленных элементов (0 или 1)
+     */
+    template<typename K>
+    requires transparent_key<K>
+    std::size_t erase(K&& key) noexcept {
+        auto it = find(key);
+        if(it != end()) {
+            erase(it);
+            return 1;
+        } else {
+            return 0;
+        }
+    }
+
+    // NODE HANDLE BLOCK
+
+    /**
+     * @brief node_type - дескриптор узла, извлеченного из Map
+     *
+     * Владеет узлом вместе с копией аллокатора и уничтожает его в деструкторе, если узел
+     * так и не был вставлен обратно. В Map с равным аллокатором узел перевешивается как есть,
+     * в Map с другим аллокатором элемент перемещается в новый узел.
+     */
+    class node_type {
+    private:
+
+        friend class Map;
+
+        Node* node_ = nullptr;
+        std::optional<node_allocator> alloc_;
+
+        node_type(Node* node, const node_allocator& alloc) noexcept : node_(node), alloc_(alloc) {}
+
+        /**
+         * @brief reset - уничтожает узел (если есть) и делает дескриптор пустым
+         */
+        void reset() noexcept {
+            if (node_ != nullptr) {
+                std::allocator_traits<node_allocator>::destroy(*alloc_, node_);
+                std::allocator_traits<node_allocator>::deallocate(*alloc_, node_, 1);
+                node_ = nullptr;
+            }
+            alloc_.reset();
+        }
+
+        /**
+         * @brief release - отдает узел (дескриптор становится пустым)
+         */
+        Node* release() noexcept {
+            Node* node = node_;
+            node_ = nullptr;
+            alloc_.reset();
+            return node;
+        }
+
+    public:
+
+        node_type() noexcept = default;
+
+        node_type(node_type&& other) noexcept : node_(other.node_), alloc_(std::move(other.alloc_)) {
+            other.node_ = nullptr;
+            other.alloc_.reset();
+        }
+
+        node_type& operator = (node_type&& other) noexcept {
+            if (this != &other) {
+                reset();
+                node_ = other.node_;
+                alloc_ = std::move(other.alloc_);
+                other.node_ = nullptr;
+                other.alloc_.reset();
+            }
+            return *this;
+        }
+
+        node_type(const node_type&) = delete;
+        node_type& operator = (const node_type&) = delete;
+
+        ~node_type() { reset(); }
+
+        /**
+         * @brief empty - пуст ли дескриптор
+         */
+        [[nodiscard]] bool empty() const noexcept { return node_ == nullptr; }
+
+        explicit operator bool () const noexcept { return node_ != nullptr; }
+
+        /**
+         * @brief key - ключ узла (дескриптор не должен быть пустым)
+         */
+        const Key& key() const noexcept { return node_->value_.first; }
+
+        /**
+         * @brief mapped - значение узла (дескриптор не должен быть пустым)
+         */
+        T& mapped() const noexcept { return node_->value_.second; }
+
+        /**
+         * @brief get_allocator - аллокатор, которым выделен узел (дескриптор не должен быть пустым)
+         */
+        Allocator get_allocator() const { return Allocator(*alloc_); }
+
+        void swap(node_type& other) noexcept {
+            std::swap(node_, other.node_);
+            std::swap(alloc_, other.alloc_);
+        }
+
+        friend void swap(node_type& lhs, node_type& rhs) noexcept { lhs.swap(rhs); }
+    };
+
+    /**
+     * @brief insert_return_type - результат insert(node_type&&)
+     *
+     * Если ключ уже был, узел возвращается обратно в node, а position указывает на существующий элемент.
+     */
+    struct insert_return_type {
+        iterator position;
+        bool inserted;
+        node_type node;
+    };
+
+private:
+
+    /**
+     * @brief same_allocator - можно ли перевесить узел, выделенный аллокатором alloc
+     *
+     * Узел из чужого пула (например, другой SlabMap) освободил бы не тот аллокатор.
+     */
+    bool same_allocator(const node_allocator& alloc) const noexcept {
+        return std::allocator_traits<node_allocator>::is_always_equal::value || node_alloc_ == alloc;
+    }
+
+    /**
+     * @brief adopt_node - забирает узел из дескриптора; при другом аллокаторе элемент перемещается в новый узел
+     *
+     * @exception std::bad_alloc при неудачном выделении памяти (узел остается в nh)
+     * @exception Любые исключения от конструкторов копирования Key и перемещения T
+     */
+    Node* adopt_node(node_type& nh) {
+        if (same_allocator(*nh.alloc_)) return nh.release();
+
+        Node* node = create_node(std::move(nh.node_->value_));
+        nh.reset();
+        return node;
+    }
+
+public:
+
+    /**
+     * @brief extract - отвязывает узел от дерева и отдает его дескриптору (без освобождения памяти)
+     *
+     * @param position - итератор на элемент (не end())
+     *
+     * @return node_type - дескриптор с узлом
+     */
+    node_type extract(const_iterator position) noexcept {
+        BaseNode* node = const_cast<BaseNode*>(position.base());
+        unlinker(node);
+
+        // Связи узла указывают в дерево, а link_node ожидает узел без детей
+        node->left_ = nullptr;
+        node->right_ = nullptr;
+        node->set_parent(nullptr);
+        return node_type(static_cast<Node*>(node), node_alloc_);
+    }
+
+    /**
+     * @brief extract - отвязывает узел с ключом key
+     *
+     * @param key - ключ
+     *
+     * @return node_type - дескриптор с узлом или пустой дескриптор, если ключа нет
+     */
+    node_type extract(const Key& key) noexcept {
+        auto it = find(key);
+        if (it == end()) return node_type();
+        return extract(it);
+    }
+
+    /**
+     * @brief insert - вставка узла из дескриптора (без выделения памяти, если аллокаторы равны)
+     *
+     * @param nh - дескриптор (может быть пустым)
+     *
+     * @return insert_return_type
+     *
+     * @exception std::bad_alloc при неудачном выделении памяти (только при разных аллокаторах)
+     * @exception Любые исключения от конструкторов копирования Key и перемещения T (только при разных аллокаторах)
+     */
+    insert_return_type insert(node_type&& nh) {
+        if (nh.empty()) return { end(), false, node_type() };
+
+        auto res = finder(nh.key());
+        if (res.existing != nullptr) return { iterator(res.existing), false, std::move(nh) };
+
+        return { link_node(res, adopt_node(nh)), true, node_type() };
+    }
+
+    /**
+     * @brief insert - вставка узла из дескриптора с подсказкой позиции (см. emplace_hint)
+     *
+     * @param hint - итератор на элемент, перед которым предполагается вставка
+     * @param nh - дескриптор (может быть пустым)
+     *
+     * @return iterator на вставленный элемент или на элемент с таким же ключом
+     *         (тогда узел остается в nh)
+     *
+     * @exception std::bad_alloc при неудачном выделении памяти (только при разных аллокаторах)
+     * @exception Любые исключения от конструкторов копирования Key и перемещения T (только при разных аллокаторах)
+     */
+    iterator insert(const_iterator hint, node_type&& nh) {
+        if (nh.empty()) return end();
+
+        auto res = hint_finder(const_cast<BaseNode*>(hint.base()), nh.key());
+        if (res.existing != nullptr) return iterator(res.existing);
+
+        return link_node(res, adopt_node(nh));
+    }
+
+    /**
+     * @brief merge - переносит в Map узлы source, ключей которых здесь еще нет
+     *
+     * При равных аллокаторах узлы перевешиваются без выделения памяти и без копирования элементов,
+     * иначе элементы перемещаются в новые узлы и удаляются из source.
+     * Элементы с уже существующими ключами остаются в source.
+     *
+     * @param source - другая Map
+     *
+     * @exception std::bad_alloc при неудачном выделении памяти (только при разных аллокаторах)
+     * @exception Любые исключения от конструкторов копирования Key и перемещения T (только при разных аллокаторах)
+     */
+    void merge(Map& source) {
+        if (&source == this) return;
+
+        const bool relink = same_allocator(source.node_alloc_);
+        auto it = source.begin();
+        while (it != source.end()) {
+            Node* node = static_cast<Node*>(it.base());
+            ++it;
+
+            // Источник обходится по возрастанию, поэтому подсказка end() часто попадает сразу
+            auto res = hint_finder(imaginary_, node->value_.first);
+            if (res.existing != nullptr) continue;
+
+            if (relink) {
+                source.unlinker(node);
+                node->left_ = nullptr;
+                node->right_ = nullptr;
+                link_node(res, node);
+            } else {
+                link_node(res, create_node(std::move(node->value_)));
+                source.eraser(node);
+            }
+        }
+    }
+
+    void merge(Map&& source) { merge(source); }
+
+    // SET OPERATIONS BLOCK
+
+private:
+
+    // Отвязанное от мнимой ноды поддерево и его черная высота
+    // (число черных узлов на пути от корня до nullptr, корень учитывается, если он черный).
+    // parent() корня не используется
+    struct Subtree {
+        BaseNode* root;
+        std::size_t black_height;
+    };
+
+    /**
+     * @brief black_height - черная высота поддерева (спуск по левому краю)
+     */
+    static std::size_t black_height(BaseNode* node) noexcept {
+        std::size_t height = 0;
+        for (; node != nullptr; node = node->left_) if (!node->is_red()) ++height;
+        return height;
+    }
+
+    /**
+     * @brief detach_tree - забирает дерево у Map, оставляя ее пустой
+     */
+    Subtree detach_tree() noexcept {
+        Subtree tree{ imaginary_->left_, black_height(imaginary_->left_) };
+        imaginary_->left_ = nullptr;
+        imaginary_->leftmost_ = imaginary_;
+        imaginary_->rightmost_ = imaginary_;
+        size_ = 0;
+        return tree;
+    }
+
+    /**
+     * @brief attach_tree - подвешивает поддерево к мнимой ноде пустой Map
+     */
+    void attach_tree(Subtree tree, std::size_t size) noexcept {
+        imaginary_->left_ = tree.root;
+        if (tree.root != nullptr) {
+            tree.root->set_parent(imaginary_);
+            tree.root->set_red(false);
+        }
+        size_ = size;
+        update_extremes();
+    }
+
+    /**
+     * @brief join_trees - объединяет left, узел middle и right (все ключи left < middle < всех ключей right)
+     *
+     * Более низкое дерево вместе с middle вставляется в край более высокого на уровне
+     * с той же черной высотой, после чего красный middle балансируется emplace_balancer.
+     * Время O(|bh(left) - bh(right)| + 1). Мнимая нода используется как временный корень,
+     * поэтому дерево самой Map в этот момент должно быть отвязано (detach_tree).
+     *
+     * @return Subtree - результат с черным корнем
+     */
+    Subtree join_trees(Subtree left, BaseNode* middle, Subtree right) noexcept {
+        if (left.root != nullptr && left.root->is_red()) { left.root->set_red(false); ++left.black_height; }
+        if (right.root != nullptr && right.root->is_red()) { right.root->set_red(false); ++right.black_height; }
+
+        if (left.black_height == right.black_height) {
+            middle->set_red(false);
+            middle->left_ = left.root;
+            middle->right_ = right.root;
+            if (left.root != nullptr) left.root->set_parent(middle);
+            if (right.root != nullptr) right.root->set_parent(middle);
+            if constexpr (counts_subtrees) recount(middle);
+            return { middle, left.black_height + 1 };
+        }
+
+        bool into_left = left.black_height > right.black_height;
+        Subtree& high = into_left ? left : right;
+        Subtree& low = into_left ? right : left;
+
+        imaginary_->left_ = high.root;
+        high.root->set_parent(imaginary_);
+
+        // Спуск по правому (левому) краю до черного узла или nullptr с черной высотой low
+        BaseNode* parent = imaginary_;
+        BaseNode* cur = high.root;
+        std::size_t height = high.black_height;
+        while (cur != nullptr && (cur->is_red() || height != low.black_height)) {
+            if (!cur->is_red()) --height;
+            parent = cur;
+            cur = into_left ? cur->right_ : cur->left_;
+        }
+
+        middle->set_red(true);
+        middle->set_parent(parent);
+        if (into_left) {
+            parent->right_ = middle;
+            middle->left_ = cur;
+            middle->right_ = low.root;
+        } else {
+            parent->left_ = middle;
+            middle->left_ = low.root;
+            middle->right_ = cur;
+        }
+        if (cur != nullptr) cur->set_parent(middle);
+        if (low.root != nullptr) low.root->set_parent(middle);
+
+        if constexpr (counts_subtrees) {
+            recount(middle);
+            add_to_ancestors(parent, subtree_size(low.root) + 1);
+        }
+
+        bool grew = emplace_balancer(middle);
+
+        Subtree result{ imaginary_->left_, high.black_height + (grew ? 1 : 0) };
+        imaginary_->left_ = nullptr;
+        return result;
+    }
+
+    /**
+     * @brief split_last - отделяет максимальный узел поддерева (непустого)
+     *
+     * @param tree - поддерево
+     * @param last - сюда записывается максимальный узел
+     *
+     * @return Subtree - поддерево без last
+     */
+    Subtree split_last(Subtree tree, BaseNode*& last) noexcept {
+        BaseNode* root = tree.root;
+        std::size_t child_height = tree.black_height - (root->is_red() ? 0 : 1);
+
+        if (root->right_ == nullptr) {
+            last = root;
+            Subtree rest{ root->left_, child_height };
+            return rest;
+        }
+        Subtree rest = split_last({ root->right_, child_height }, last);
+        return join_trees({ root->left_, child_height }, root, rest);
+    }
+
+    /**
+     * @brief join_trees - объединяет два поддерева (все ключи left < всех ключей right) без среднего узла
+     */
+    Subtree join_trees(Subtree left, Subtree right) noexcept {
+        if (left.root == nullptr) return right;
+        if (right.root == nullptr) return left;
+
+        BaseNode* last = nullptr;
+        Subtree rest = split_last(left, last);
+        return join_trees(rest, last, right);
+    }
+
+    /**
+     * @brief split_tree - делит поддерево по ключу на ключи < key, узел с ключом key (или nullptr) и ключи > key
+     *
+     * Время O(log n): на каждом уровне спуска выполняется один join_trees, а их стоимости
+     * в сумме телескопируются.
+     */
+    template<typename K>
+    void split_tree(Subtree tree, const K& key, Subtree& less, BaseNode*& equal, Subtree& greater) noexcept {
+        if (tree.root == nullptr) {
+            less = greater = { nullptr, 0 };
+            equal = nullptr;
+            return;
+        }
+
+        BaseNode* root = tree.root;
+        std::size_t child_height = tree.black_height - (root->is_red() ? 0 : 1);
+        Subtree left{ root->left_, child_height };
+        Subtree right{ root->right_, child_height };
+        const Key& root_key = static_cast<Node*>(root)->value_.first;
+
+        if (comp_(key, root_key)) {
+            Subtree part;
+            split_tree(left, key, less, equal, part);
+            greater = join_trees(part, root, right);
+        } else if (comp_(root_key, key)) {
+            Subtree part;
+            split_tree(right, key, part, equal, greater);
+            less = join_trees(left, root, part);
+        } else {
+            less = left;
+            equal = root;
+            greater = right;
+        }
+    }
+
+    /**
+     * @brief destroy_tree - уничтожает все узлы поддерева
+     */
+    void destroy_tree(Subtree tree) noexcept {
+        if (tree.root != nullptr) cleaner(tree.root);
+    }
+
+    /**
+     * @brief union_trees - объединение: узлы a и узлы b, ключей которых нет в a (дубликаты из b уничтожаются)
+     *
+     * @param removed - увеличивается на число уничтоженных узлов
+     */
+    Subtree union_trees(Subtree a, Subtree b, std::size_t& removed) noexcept {
+        if (a.root == nullptr) return b;
+        if (b.root == nullptr) return a;
+
+        BaseNode* root = a.root;
+        std::size_t child_height = a.black_height - (root->is_red() ? 0 : 1);
+
+        Subtree b_less, b_greater;
+        BaseNode* b_equal;
+        split_tree(b, static_cast<Node*>(root)->value_.first, b_less, b_equal, b_greater);
+        if (b_equal != nullptr) {
+            destroy_node(static_cast<Node*>(b_equal));
+            ++removed;
+        }
+
+        Subtree left = union_trees({ root->left_, child_height }, b_less, removed);
+        Subtree right = union_trees({ root->right_, child_height }, b_greater, removed);
+        return join_trees(left, root, right);
+    }
+
+    /**
+     * @brief intersect_trees - пересечение: узлы a, ключи которых есть в b (остальные узлы a и все узлы b уничтожаются)
+     *
+     * @param kept - увеличивается на число оставшихся узлов
+     */
+    Subtree intersect_trees(Subtree a, Subtree b, std::size_t& kept) noexcept {
+        if (a.root == nullptr || b.root == nullptr) {
+            destroy_tree(a);
+            destroy_tree(b);
+            return { nullptr, 0 };
+        }
+
+        BaseNode* root = a.root;
+        std::size_t child_height = a.black_height - (root->is_red() ? 0 : 1);
+
+        Subtree b_less, b_greater;
+        BaseNode* b_equal;
+        split_tree(b, static_cast<Node*>(root)->value_.first, b_less, b_equal, b_greater);
+
+        Subtree left = intersect_trees({ root->left_, child_height }, b_less, kept);
+        Subtree right = intersect_trees({ root->right_, child_height }, b_greater, kept);
+
+        if (b_equal != nullptr) {
+            destroy_node(static_cast<Node*>(b_equal));
+            ++kept;
+            return join_trees(left, root, right);
+        }
+        destroy_node(static_cast<Node*>(root));
+        return join_trees(left, right);
+    }
+
+    /**
+     * @brief difference_trees - разность: узлы a, ключей которых нет в b (все узлы b и совпавшие узлы a уничтожаются)
+     *
+     * @param removed - увеличивается на число уничтоженных узлов a
+     */
+    Subtree difference_trees(Subtree a, Subtree b, std::size_t& removed) noexcept {
+        if (a.root == nullptr || b.root == nullptr) {
+            destroy_tree(b);
+            return a;
+        }
+
+        BaseNode* root = b.root;
+        std::size_t child_height = b.black_height - (root->is_red() ? 0 : 1);
+
+        Subtree a_less, a_greater;
+        BaseNode* a_equal;
+        split_tree(a, static_cast<Node*>(root)->value_.first, a_less, a_equal, a_greater);
+        if (a_equal != nullptr) {
+            destroy_node(static_cast<Node*>(a_equal));
+            ++removed;
+        }
+
+        Subtree left = difference_trees(a_less, { root->left_, child_height }, removed);
+        Subtree right = difference_trees(a_greater, { root->right_, child_height }, removed);
+        destroy_node(static_cast<Node*>(root));
+        return join_trees(left, right);
+    }
+
+public:
+
+    /**
+     * @brief split - переносит элементы с ключами >= key в новую Map
+     *
+     * Дерево делится за O(log n) без выделения памяти и без копирования элементов. Размеры частей
+     * определяются одновременным обходом обеих частей, то есть за O(min(размер левой, размер правой)),
+     * а с order_statistics - за O(1).
+     *
+     * @param key - граница
+     *
+     * @return Map - элементы с ключами >= key (в *this остаются ключи < key)
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти (под мнимую ноду результата)
+     */
+    Map split(const Key& key) {
+        Map result(comp_, alloc_);
+
+        std::size_t total = size_;
+        Subtree less, greater;
+        BaseNode* equal;
+        split_tree(detach_tree(), key, less, equal, greater);
+        if (equal != nullptr) greater = join_trees({ nullptr, 0 }, equal, greater);
+
+        attach_tree(less, 0);
+        result.attach_tree(greater, 0);
+
+        if constexpr (counts_subtrees) {
+            size_ = subtree_size(less.root);
+            result.size_ = total - size_;
+            return result;
+        }
+
+        // Обходим обе части поочередно, пока одна не закончится
+        std::size_t counted = 0;
+        iterator l = begin(), r = result.begin();
+        while (l != end() && r != result.end()) { ++l; ++r; ++counted; }
+        if (l == end()) {
+            size_ = counted;
+            result.size_ = total - counted;
+        } else {
+            result.size_ = counted;
+            size_ = total - counted;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief join - объединяет две Map, все ключи left которых меньше всех ключей right
+     *
+     * Время O(log n) без выделения памяти. Если аллокатор right не равен аллокатору left,
+     * элементы right сначала перемещаются в новые узлы.
+     *
+     * @param left - Map с меньшими ключами (ее компаратор и аллокатор достаются результату)
+     * @param right - Map с большими ключами
+     *
+     * @return Map - объединение
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструкторов копирования Key и перемещения T (только при разных аллокаторах)
+     */
+    static Map join(Map&& left, Map&& right) {
+        Map result(std::move(left));
+        if (right.empty()) return result;
+
+        if (!result.same_allocator(right.node_alloc_)) {
+            Map rehomed(std::move(right), result.alloc_);
+            return join(std::move(result), std::move(rehomed));
+        }
+
+        std::size_t total = result.size_ + right.size_;
+        Subtree low = result.detach_tree();
+        Subtree high = right.detach_tree();
+
+        if (low.root == nullptr) {
+            result.attach_tree(high, total);
+            return result;
+        }
+
+        // Максимум left становится средним узлом join
+        BaseNode* last = nullptr;
+        Subtree rest = result.split_last(low, last);
+        result.attach_tree(result.join_trees(rest, last, high), total);
+        return result;
+    }
+
+    /**
+     * @brief union_with - добавляет элементы other, ключей которых нет в *this (other становится пустой)
+     *
+     * При совпадении ключей остается значение из *this. Время O(m log(n/m + 1)), где m - размер
+     * меньшей из Map; узлы перевешиваются без выделения памяти. При разных аллокаторах
+     * элементы other перемещаются в новые узлы поштучно (см. merge).
+     *
+     * @param other - вторая Map
+     *
+     * @exception std::bad_alloc при неудачном выделении памяти (только при разных аллокаторах)
+     * @exception Любые исключения от конструкторов копирования Key и перемещения T (только при разных аллокаторах)
+     */
+    void union_with(Map&& other) {
+        if (&other == this) return;
+
+        if (!same_allocator(other.node_alloc_)) {
+            merge(other);
+            other.clear();
+            return;
+        }
+
+        std::size_t total = size_ + other.size_;
+        std::size_t removed = 0;
+        Subtree b = other.detach_tree();
+        Subtree tree = union_trees(detach_tree(), b, removed);
+        attach_tree(tree, total - removed);
+    }
+
+    /**
+     * @brief intersect_with - оставляет только элементы, ключи которых есть в other (other становится пустой)
+     *
+     * Время O(m log(n/m + 1)) плюс освобождение удаленных узлов. Узлы other освобождает ее собственный
+     * аллокатор, поэтому при разных аллокаторах ключи проверяются поштучно за O(n log m).
+     *
+     * @param other - вторая Map
+     */
+    void intersect_with(Map&& other) noexcept {
+        if (&other == this) return;
+
+        if (!same_allocator(other.node_alloc_)) {
+            for (auto it = begin(); it != end();) {
+                if (other.contains(it->first)) ++it;
+                else it = erase(it);
+            }
+            other.clear();
+            return;
+        }
+
+        std::size_t kept = 0;
+        Subtree b = other.detach_tree();
+        Subtree tree = intersect_trees(detach_tree(), b, kept);
+        attach_tree(tree, kept);
+    }
+
+    /**
+     * @brief difference_with - удаляет элементы, ключи которых есть в other (other становится пустой)
+     *
+     * Время O(m log(n/m + 1)) плюс освобождение удаленных узлов. Узлы other освобождает ее собственный
+     * аллокатор, поэтому при разных аллокаторах ключи удаляются поштучно за O(m log n).
+     *
+     * @param other - вторая Map
+     */
+    void difference_with(Map&& other) noexcept {
+        if (&other == this) {
+            clear();
+            return;
+        }
+
+        if (!same_allocator(other.node_alloc_)) {
+            for (const auto& kv : other) erase(find(kv.first));
+            other.clear();
+            return;
+        }
+
+        std::size_t total = size_;
+        std::size_t removed = 0;
+        Subtree b = other.detach_tree();
+        Subtree tree = difference_trees(detach_tree(), b, removed);
+        attach_tree(tree, total - removed);
+    }
+
     // ACCESS BLOCK
 
     /**
@@ -1510,19 +3256,62 @@ public:
     }
 
     /**
-     * @brief operator [] - вставляет пару (key, T()), если key, иначе - возвращает знацение по ключу
+     * @brief at - гетерогенный доступ по ключу (только для прозрачного компаратора)
      *
-     * @param key - ключ
+     * @param key - значение, сравнимое с Key
+     *
+     * @exception std::out_of_range в случае, если Map не содержит key
      *
      * @return T&
      */
-    T& operator[](const Key& key) noexcept {
+    template<typename K>
+    requires transparent_key<K>
+    T& at(const K& key) {
         auto res = finder(key);
         if (res.existing != nullptr) return res.existing->value_.second;
-        else {
-            auto [it, _] = emplace(key, T());
-            return it->second;
-        }
+        else throw std::out_of_range("Map doesent contains such element");
+    }
+
+    template<typename K>
+    requires transparent_key<K>
+    const T& at(const K& key) const {
+        auto res = finder(key);
+        if (res.existing != nullptr) return res.existing->value_.second;
+        else throw std::out_of_range("Map doesent contains such element");
+    }
+
+    /**
+     * @brief operator [] - вставляет пару (key, T()), если key нет, иначе - возвращает значение по ключу
+     *
+     * Дерево обходится один раз: точка вставки берется из того же поиска.
+     *
+     * @param key - ключ
+     *
+     * @return T&
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора копирования Key или дефолтного конструктора T
+     */
+    T& operator[](const Key& key)
+        requires std::default_initializable<T>
+    {
+        return try_emplace(key).first->second;
+    }
+
+    /**
+     * @brief operator [] - вставляет пару (key, T()), если key нет, иначе - возвращает значение по ключу
+     *
+     * @param key - ключ (перемещается, только если элемент вставлен)
+     *
+     * @return T&
+     *
+     * @exception std::bad_alloc при невозможности выделения памяти
+     * @exception Любые исключения от конструктора перемещения Key или дефолтного конструктора T
+     */
+    T& operator[](Key&& key)
+        requires std::default_initializable<T>
+    {
+        return try_emplace(std::move(key)).first->second;
     }
 
     //ETC BLOCK
@@ -1540,6 +3329,19 @@ public:
         else return false;
     }
 
+    /**
+     * @brief contains - гетерогенная проверка наличия ключа (только для прозрачного компаратора)
+     *
+     * @param key - значение, сравнимое с Key
+     *
+     * @return true, если ключ есть, иначе false
+     */
+    template<typename K>
+    requires transparent_key<K>
+    bool contains(const K& key) const noexcept {
+        return finder(key).existing != nullptr;
+    }
+
     /**
      * @brief size - количество пар в дереве
      *
@@ -1554,32 +3356,101 @@ public:
      */
     bool empty() const noexcept { return size_ == 0; }
 
+    /**
+     * @brief get_allocator - копия аллокатора
+     *
+     * Перемещение и swap() забирают узлы other без поэлементного копирования, только если аллокаторы равны
+     *
+     * @return allocator_type
+     */
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
     /**
      * @brief clear - очистка контейнера
      */
-    void clear() noexcept { cleaner(imaginary_->left_); size_ = 0; }
+    void clear() noexcept {
+        cleaner(imaginary_->left_);
+        imaginary_->left_ = nullptr;
+        size_ = 0;
+        imaginary_->leftmost_ = imaginary_;
+        imaginary_->rightmost_ = imaginary_;
+    }
+
+    /**
+     * @brief assign_sorted - заменяет содержимое элементами отсортированного диапазона без повторов
+     *
+     * Для forward-итераторов дерево собирается сразу сбалансированным за O(n): без сравнений
+     * ключей и без поворотов. Если диапазон не отсортирован по comp_ или содержит равные ключи,
+     * поведение не определено. Для input-итераторов элементы вставляются с подсказкой end()
+     * (тоже O(n) для отсортированного входа).
+     *
+     * @param first - итератор на начало диапазона
+     * @param last - итератор на конец диапазона
+     *
+     * @exception Любые исключения от конструктора std::pair<const Key, T>. Для forward-итераторов
+     *            содержимое Map при этом не меняется
+     */
+    template<typename InputIt>
+    requires std::constructible_from<std::pair<const Key, T>, std::iter_reference_t<InputIt>>
+    void assign_sorted(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            BaseNode* root = builder(first, n, 0, std::bit_width(n + 1) - 1);
+
+            clear();
+            if (root != nullptr) {
+                imaginary_->left_ = root;
+                root->set_parent(imaginary_);
+            }
+            size_ = n;
+            update_extremes();
+        } else {
+            clear();
+            for (; first != last; ++first) emplace_hint(end(), *first);
+        }
+    }
 
     /**
      * @brief swap - обмен содержимым двух Map
      *
+     * Аллокаторы обмениваются, только если propagate_on_container_swap;
+     * иначе они должны быть равны.
+     *
      * @param other - другая Map
      */
     void swap(Map& other) noexcept {
-        // Обмениваем указатели на imaginary_
-        std::swap(imaginary_, other.imaginary_);
-
-        // Обмениваем размер
-        std::swap(size_, other.size_);
-
-        // Обмениваем компаратор
-        std::swap(comp_, other.comp_);
-
-        // Обмениваем аллокаторы
-        std::swap(alloc_, other.alloc_);
-        std::swap(node_alloc_, other.node_alloc_);
-        std::swap(base_alloc_, other.base_alloc_);
+        swap_storage(other);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) swap_allocators(other);
     }
 };
 
+/**
+ * @brief SlabMap - Map, узлы которой нарезаются из собственного пула (SlabAllocator)
+ *
+ * Вставка не обращается к malloc, а память под узлы выделяется крупными порциями,
+ * поэтому узлы лежат плотно и обход дерева дружелюбнее к кэшу. Интерфейс совпадает с Map.
+ */
+template<typename Key, typename T, typename Compare = std::less<Key>>
+using SlabMap = Map<Key, T, Compare, SlabAllocator<std::pair<const Key, T>>>;
+
+/**
+ * @brief OrderStatisticsMap - Map с размерами поддеревьев в узлах (политика order_statistics)
+ *
+ * Помимо интерфейса Map: nth(k), rank(key), index_of(it) и distance(first, last) за O(log n).
+ */
+template<typename Key, typename T, typename Compare = std::less<Key>,
+         typename Allocator = std::allocator<std::pair<const Key, T>>>
+using OrderStatisticsMap = Map<Key, T, Compare, Allocator, order_statistics>;
+
+/**
+ * @brief CompactMap - Map с цветом узла в младшем бите указателя на родителя (раскладка compact_nodes)
+ *
+ * Узел на 8 байт меньше (на 64-битной платформе), поэтому в кэш помещается больше дерева. Выигрыш по памяти
+ * заметен с пулом (SlabAllocator): malloc может округлить оба размера узла до одного класса. Интерфейс совпадает с Map.
+ */
+template<typename Key, typename T, typename Compare = std::less<Key>,
+         typename Allocator = std::allocator<std::pair<const Key, T>>>
+using CompactMap = Map<Key, T, Compare, Allocator, no_augmentation, compact_nodes>;
+
 }
 #endif // MAP_HPP
@@ -0,0 +1,75 @@
+#ifndef MAPTRAITS_HPP
+#define MAPTRAITS_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// CURRENT VERSION v0.1.1
+
+// CHANGELOG:
+// > Условие гетерогенного поиска transparent_key
+
+// Общие вспомогательные шаблоны ассоциативных контейнеров: извлечение ключа из аргументов emplace
+// и условие гетерогенного поиска. Контейнер подставляет свои Key, функторы и итераторы,
+// поэтому шаблоны ничего не знают о его устройстве.
+
+namespace mystl::detail {
+
+/**
+ * @brief is_key_pair - P это std::pair, первый элемент которой - Key (value_type или std::pair<Key, T>)
+ */
+template<typename P, typename Key>
+inline constexpr bool is_key_pair = requires {
+    typename P::first_type;
+    typename P::second_type;
+    requires std::is_same_v<P, std::pair<typename P::first_type, typename P::second_type>>;
+    requires std::is_same_v<std::remove_cv_t<typename P::first_type>, Key>;
+};
+
+/**
+ * @brief key_is_extractable - можно ли достать ключ из аргументов emplace без сборки элемента
+ *
+ * @return true для emplace(key, value) и emplace(pair)
+ */
+template<typename Key, typename... Args>
+constexpr bool key_is_extractable() noexcept {
+    if constexpr (sizeof...(Args) == 2) {
+        return std::is_same_v<std::remove_cvref_t<std::tuple_element_t<0, std::tuple<Args...>>>, Key>;
+    } else if constexpr (sizeof...(Args) == 1) {
+        return (is_key_pair<std::remove_cvref_t<Args>, Key> && ...);
+    } else {
+        return false;
+    }
+}
+
+/**
+ * @brief extract_key - ключ из аргументов emplace (см. key_is_extractable)
+ */
+template<typename Key, typename First, typename... Rest>
+constexpr const Key& extract_key(const First& first, const Rest&...) noexcept {
+    if constexpr (sizeof...(Rest) == 0) return first.first;
+    else return first;
+}
+
+/**
+ * @brief is_transparent - функтор умеет работать не только с Key (std::less<>, std::ranges::less,
+ *        прозрачные хеш-функции), и тогда поиск принимает другие типы без создания временного Key
+ */
+template<typename F>
+inline constexpr bool is_transparent = requires { typename F::is_transparent; };
+
+/**
+ * @brief transparent_key - K подходит для гетерогенного поиска: все функторы Functors прозрачны,
+ *        а K не приводится к итераторам Iterators (иначе, например, erase(K) перехватил бы erase(iterator))
+ */
+template<typename K, typename Functors, typename... Iterators>
+inline constexpr bool transparent_key = false;
+
+template<typename K, typename... Functors, typename... Iterators>
+inline constexpr bool transparent_key<K, std::tuple<Functors...>, Iterators...> =
+    (is_transparent<Functors> && ...) && (!std::is_convertible_v<K, Iterators> && ...);
+
+} // namespace mystl::detail
+
+#endif // MAPTRAITS_HPP
@@ -0,0 +1,230 @@
+#ifndef POOLALLOCATOR_HPP
+#define POOLALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+
+// CURRENT VERSION v0.1.0
+
+// Пул блоков фиксированных размеров. В отличие от Arena, освобожденный блок
+// возвращается в список свободных своего размерного класса и переиспользуется,
+// поэтому пул подходит для долгоживущих контейнеров с частыми вставками/удалениями
+// (узлы Map). Блоки берутся у operator new крупными порциями и возвращаются
+// только в release() или в деструкторе.
+
+namespace mystl {
+
+/**
+ * @brief Pool - источник памяти со списками свободных блоков по размерным классам
+ *
+ * Запросы до max_block_size байт с выравниванием не больше alignof(std::max_align_t)
+ * обслуживаются из списков свободных блоков, остальные - напрямую operator new.
+ * Не потокобезопасен. Не копируется и не перемещается: аллокаторы хранят на него указатель.
+ */
+class Pool {
+public:
+
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+    static constexpr std::size_t max_block_size = 512;
+
+private:
+
+    static constexpr std::size_t class_count = max_block_size / granularity;
+    static constexpr std::size_t min_blocks_per_chunk = 16;
+    static constexpr std::size_t max_blocks_per_chunk = 1024;
+
+    // Свободный блок хранит указатель на следующий свободный блок в себе самом
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Заголовок порции блоков. Занимает granularity байт, чтобы блоки оставались выровненными
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+    };
+
+    struct SizeClass {
+        FreeBlock* free = nullptr;
+        std::size_t next_chunk_blocks = min_blocks_per_chunk;
+    };
+
+    SizeClass classes_[class_count];
+    Chunk* chunks_ = nullptr;
+
+    /**
+     * @brief class_index - номер размерного класса для запроса в bytes байт
+     */
+    static constexpr std::size_t class_index(std::size_t bytes) noexcept {
+        return bytes == 0 ? 0 : (bytes - 1) / granularity;
+    }
+
+    /**
+     * @brief is_pooled - обслуживается ли запрос списками свободных блоков
+     */
+    static constexpr bool is_pooled(std::size_t bytes, std::size_t align) noexcept {
+        return bytes <= max_block_size && align <= granularity;
+    }
+
+    /**
+     * @brief refill - запрашивает у operator new новую порцию блоков для класса index
+     *
+     * Блоки кладутся в список свободных по возрастанию адресов, так что
+     * последовательные выделения получают соседние участки памяти.
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    void refill(std::size_t index) {
+        SizeClass& cls = classes_[index];
+        std::size_t block = (index + 1) * granularity;
+        std::size_t count = cls.next_chunk_blocks;
+
+        void* raw = ::operator new(sizeof(Chunk) + count * block);
+        Chunk* chunk = static_cast<Chunk*>(raw);
+        chunk->next = chunks_;
+        chunks_ = chunk;
+
+        std::byte* first = reinterpret_cast<std::byte*>(chunk + 1);
+        for (std::size_t i = count; i > 0; --i) {
+            FreeBlock* b = reinterpret_cast<FreeBlock*>(first + (i - 1) * block);
+            b->next = cls.free;
+            cls.free = b;
+        }
+
+        cls.next_chunk_blocks = std::min(count * 2, max_blocks_per_chunk);
+    }
+
+public:
+
+    Pool() noexcept = default;
+
+    Pool(const Pool&) = delete;
+    Pool& operator = (const Pool&) = delete;
+
+    /**
+     * @brief Деструктор - освобождает все порции
+     */
+    ~Pool() { release(); }
+
+    /**
+     * @brief allocate - выделение bytes байт с выравниванием align
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        if (!is_pooled(bytes, align)) {
+            if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) return ::operator new(bytes, std::align_val_t(align));
+            return ::operator new(bytes);
+        }
+
+        std::size_t index = class_index(bytes);
+        if (classes_[index].free == nullptr) refill(index);
+
+        FreeBlock* b = classes_[index].free;
+        classes_[index].free = b->next;
+        return b;
+    }
+
+    /**
+     * @brief deallocate - возврат блока в список свободных
+     *
+     * bytes и align должны совпадать с переданными в allocate().
+     */
+    void deallocate(void* p, std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept {
+        if (p == nullptr) return;
+
+        if (!is_pooled(bytes, align)) {
+            if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) ::operator delete(p, std::align_val_t(align));
+            else ::operator delete(p);
+            return;
+        }
+
+        FreeBlock* b = static_cast<FreeBlock*>(p);
+        std::size_t index = class_index(bytes);
+        b->next = classes_[index].free;
+        classes_[index].free = b;
+    }
+
+    /**
+     * @brief release - возвращает все порции operator delete
+     *
+     * Все блоки, выданные пулом (кроме крупных, выделенных напрямую), становятся невалидными.
+     */
+    void release() noexcept {
+        while (chunks_ != nullptr) {
+            Chunk* next = chunks_->next;
+            ::operator delete(static_cast<void*>(chunks_));
+            chunks_ = next;
+        }
+        for (SizeClass& cls : classes_) cls = SizeClass();
+    }
+};
+
+/**
+ * @brief PoolAllocator - аллокатор, берущий память у Pool
+ *
+ * Аллокатор не распространяется при присваивании и swap: контейнер остается на том пуле,
+ * на котором был создан.
+ *
+ * @tparam T - тип элементов
+ */
+template<typename T>
+class PoolAllocator {
+private:
+
+    template<typename> friend class PoolAllocator;
+
+    Pool* pool_;
+
+public:
+
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    /**
+     * @brief PoolAllocator - конструктор от пула
+     *
+     * @param pool - пул, который должен пережить все контейнеры с этим аллокатором
+     */
+    PoolAllocator(Pool& pool) noexcept : pool_(&pool) {}
+
+    /**
+     * @brief PoolAllocator - конструктор из аллокатора другого типа (rebind)
+     */
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+    /**
+     * @brief allocate - выделение памяти под n объектов T
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(pool_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief deallocate - возврат памяти в пул
+     */
+    void deallocate(T* p, std::size_t n) noexcept { pool_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    /**
+     * @brief pool - пул, из которого берется память
+     */
+    Pool& pool() const noexcept { return *pool_; }
+
+    template<typename U>
+    bool operator == (const PoolAllocator<U>& other) const noexcept { return pool_ == other.pool_; }
+};
+
+} // namespace mystl
+
+#endif // POOLALLOCATOR_HPP
@@ -0,0 +1,88 @@
+#ifndef RELOCATION_HPP
+#define RELOCATION_HPP
+
+#include <type_traits>
+#include <memory>
+#include <utility>
+#include <cstring>
+#include <cstddef>
+
+// CURRENT VERSION v0.1.0
+
+namespace mystl {
+
+//TRIVIAL RELOCATION TRAIT BLOCK
+
+/**
+ * @brief is_trivially_relocatable - можно ли перенести объект T в другую память побайтово
+ *
+ * Перенос (relocation) = конструктор перемещения в новое место + деструктор старого объекта.
+ * Если тип тривиально переносим, эту пару можно заменить одним memcpy, а старый объект
+ * просто забыть.
+ *
+ * По умолчанию true только для тривиально копируемых типов. Пользовательские типы,
+ * которые не хранят указателей на самих себя (например, структуры с std::unique_ptr),
+ * могут включить оптимизацию явной специализацией:
+ *
+ *     template<> struct mystl::is_trivially_relocatable<MyType> : std::true_type {};
+ */
+template<typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/**
+ * @brief allocator_relocates_bitwise_v - можно ли переносить T побайтово при работе через Allocator
+ *
+ * Помимо самого типа требуется, чтобы аллокатор не переопределял construct()/destroy():
+ * иначе пропуск этих вызовов изменит наблюдаемое поведение аллокатора.
+ */
+template<typename T, typename Allocator>
+inline constexpr bool allocator_relocates_bitwise_v =
+    is_trivially_relocatable_v<T> &&
+    !requires(Allocator& a, T* p) { a.construct(p, std::declval<T&&>()); } &&
+    !requires(Allocator& a, T* p) { a.destroy(p); };
+
+//RELOCATION ALGORITHMS BLOCK
+
+/**
+ * @brief uninitialized_relocate_n - переносит n объектов из first в неинициализированную память dest
+ *
+ * Для побайтово переносимых типов - один memcpy без вызова деструкторов.
+ * Для остальных - поэлементное конструирование через std::move_if_noexcept,
+ * после чего исходные объекты уничтожаются.
+ *
+ * Области [first, first + n) и [dest, dest + n) не должны пересекаться.
+ *
+ * @param alloc - аллокатор, через который конструируются/уничтожаются объекты
+ * @param first - указатель на первый переносимый объект
+ * @param n - количество объектов
+ * @param dest - указатель на неинициализированную память
+ *
+ * @exception Любые исключения от конструктора перемещения/копирования T.
+ *            В этом случае исходный диапазон не изменяется, а dest остается неинициализированным
+ */
+template<typename T, typename Allocator>
+void uninitialized_relocate_n(Allocator& alloc, T* first, std::size_t n, T* dest) {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    if (n == 0) return;
+
+    if constexpr (allocator_relocates_bitwise_v<T, Allocator>) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+    } else {
+        std::size_t i = 0;
+        try {
+            for (; i < n; ++i) AllocatorTraits::construct(alloc, dest + i, std::move_if_noexcept(first[i]));
+        } catch (...) {
+            for (std::size_t j = 0; j < i; ++j) AllocatorTraits::destroy(alloc, dest + j);
+            throw;
+        }
+        for (std::size_t k = 0; k < n; ++k) AllocatorTraits::destroy(alloc, first + k);
+    }
+}
+
+} // namespace mystl
+
+#endif // RELOCATION_HPP
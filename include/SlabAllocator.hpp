@@ -0,0 +1,98 @@
+#ifndef SLABALLOCATOR_HPP
+#define SLABALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "PoolAllocator.hpp"
+
+// CURRENT VERSION v0.1.0
+
+// Slab-аллокатор для узловых контейнеров (Map). В отличие от PoolAllocator,
+// пул не внешний: он создается вместе с аллокатором и принадлежит контейнеру
+// (и всем копиям/rebind-ам его аллокатора). Узлы нарезаются из порций по 16..1024 штук
+// и после удаления попадают в интрузивный список свободных, поэтому вставка
+// не обращается к malloc, а соседние по времени создания узлы лежат рядом в памяти.
+// Пул освобождается целиком, когда уничтожается последний аллокатор, т.е. сам контейнер.
+
+namespace mystl {
+
+/**
+ * @brief SlabAllocator - аллокатор с собственным пулом узлов
+ *
+ * Копии и rebind-ы аллокатора делят один пул (все узлы одной Map в одном пуле).
+ * Копия контейнера получает новый пул (select_on_container_copy_construction),
+ * а при перемещении и swap пул уходит вместе с узлами.
+ *
+ * Как и контейнеры mystl, не потокобезопасен: пул принадлежит одному контейнеру,
+ * поэтому разделяемого между потоками состояния (и потребности в thread-local кэшах) нет.
+ *
+ * @tparam T - тип элементов
+ */
+template<typename T>
+class SlabAllocator {
+private:
+
+    template<typename> friend class SlabAllocator;
+
+    std::shared_ptr<Pool> pool_;
+
+public:
+
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    /**
+     * @brief SlabAllocator - конструктор, создает новый пул
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    SlabAllocator() : pool_(std::make_shared<Pool>()) {}
+
+    // Конструктора перемещения нет намеренно: перемещенный аллокатор обязан
+    // остаться рабочим, иначе он не сможет освободить оставшиеся у него узлы
+    SlabAllocator(const SlabAllocator&) noexcept = default;
+    SlabAllocator& operator = (const SlabAllocator&) noexcept = default;
+
+    /**
+     * @brief SlabAllocator - конструктор из аллокатора другого типа (rebind), пул общий
+     */
+    template<typename U>
+    SlabAllocator(const SlabAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+    /**
+     * @brief select_on_container_copy_construction - копия контейнера получает свой пул
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    SlabAllocator select_on_container_copy_construction() const { return SlabAllocator(); }
+
+    /**
+     * @brief allocate - выделение памяти под n объектов T
+     *
+     * @exception std::bad_alloc при невозможности выделить память
+     */
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(pool_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief deallocate - возврат памяти в список свободных
+     */
+    void deallocate(T* p, std::size_t n) noexcept { pool_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    template<typename U>
+    bool operator == (const SlabAllocator<U>& other) const noexcept { return pool_ == other.pool_; }
+};
+
+} // namespace mystl
+
+#endif // SLABALLOCATOR_HPP
@@ -0,0 +1,796 @@
+#ifndef STATICARRAY_HPP
+#define STATICARRAY_HPP
+
+#include <type_traits>
+#include <stdexcept>
+#include <initializer_list>
+#include <concepts>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <algorithm>
+#include <utility>
+
+#include "ArrayIterator.hpp"
+#include "ArrayAlgorithms.hpp"
+
+// CURRENT VERSION v0.1.2
+
+// CHANGELOG:
+// > Уточнена документация: constexpr-переменная StaticArray возможна только для заполненного массива
+// > append_range() принимает однопроходные sized-диапазоны с только перемещаемым итератором
+
+// StaticArray - массив с ёмкостью Capacity, известной на этапе компиляции.
+// Элементы хранятся прямо в объекте, куча не используется никогда.
+// Интерфейс и поведение совпадают с DynamicArray: итератор и алгоритмы
+// вставки/удаления общие (ArrayIterator.hpp, ArrayAlgorithms.hpp).
+// Выход за ёмкость бросает std::bad_alloc, как неудачная аллокация в DynamicArray.
+// Все операции constexpr (в constexpr-функциях; см. деструктор о constexpr-переменных).
+
+namespace mystl {
+
+template<typename T, size_t Capacity>
+requires (Capacity > 0)
+class StaticArray {
+private:
+
+    // Элементы создаются по одному через construct_at, поэтому массив лежит в union:
+    // иначе при создании StaticArray были бы сконструированы все Capacity элементов
+    union {
+        T arr[Capacity];
+    };
+
+    size_t sz;
+
+    // Аллокатор только конструирует и уничтожает элементы, память он не выделяет.
+    // Он статический: член типа std::allocator сделал бы деструктор StaticArray нетривиальным
+    using Allocator = std::allocator<T>;
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static inline Allocator alloc{};
+
+    //COMMON ITERATOR BLOCK
+
+    template <bool IsConst>
+    using common_iterator = array_iterator<T, IsConst>;
+
+public:
+
+    //ORDINARY ITERATOR BLOCK
+
+    using iterator = common_iterator<false>;
+    using const_iterator = common_iterator<true>;
+
+    constexpr iterator begin() { return iterator(arr); }
+    constexpr const_iterator begin() const { return const_iterator(arr); }
+
+    constexpr iterator end() { return iterator(arr + sz); }
+    constexpr const_iterator end() const { return const_iterator(arr + sz); }
+
+    //REVERSED ITERATOR BLOCK
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    //BASIC FUNCTIONAL BLOCK
+
+    /**
+     * @brief Конструктор по умолчанию. Создает пустой StaticArray.
+     *
+     * @exception Не бросает исключений
+     */
+    constexpr StaticArray() noexcept : sz(0) {}
+
+    /**
+     * @brief Конструктор с заданным размером и значением (для копируемых типов).
+     *
+     * @param size Начальный размер массива
+     * @param value Значение для инициализации элементов
+     *
+     * @exception std::bad_alloc Если size > Capacity
+     * @exception Любые исключения от конструктора копирования T
+     */
+    constexpr explicit StaticArray(size_t size, const T& value = T())
+    requires std::copy_constructible<T>
+        : sz(0)
+    {
+        check_capacity(size);
+        detail::construct_n_from(alloc, detail::fill_iterator<T>(&value, 0), size, arr);
+        sz = size;
+    }
+
+    /**
+     * @brief Конструктор с заданным размером (для некопируемых типов).
+     *
+     * @param size Начальный размер массива
+     *
+     * @exception std::bad_alloc Если size > Capacity
+     * @exception Любые исключения от дефолтного конструктора T
+     */
+    constexpr explicit StaticArray(size_t size)
+    requires (!std::copy_constructible<T> && std::default_initializable<T>)
+        : sz(0)
+    {
+        resize(size);
+    }
+
+    /**
+     * @brief Конструктор с заданным размером без инициализации значением.
+     *
+     * @param size Начальный размер массива
+     *
+     * @exception std::bad_alloc Если size > Capacity
+     * @exception Любые исключения от дефолтного конструктора T
+     */
+    constexpr StaticArray(size_t size, default_init_t)
+    requires std::default_initializable<T>
+        : sz(0)
+    {
+        resize_for_overwrite(size);
+    }
+
+    /**
+     * @brief Конструктор из списка инициализации.
+     *
+     * @param list
+     *
+     * @exception std::bad_alloc Если list.size() > Capacity
+     * @exception Любые исключения от конструктора копирования T
+     */
+    constexpr StaticArray(std::initializer_list<T> list)
+    requires std::copy_constructible<T>
+        : sz(0)
+    {
+        check_capacity(list.size());
+        detail::construct_n_from(alloc, list.begin(), list.size(), arr);
+        sz = list.size();
+    }
+
+    /**
+     * @brief Конструктор из диапазона [first, last).
+     *
+     * @param first Итератор на начало диапазона
+     * @param last Итератор на конец диапазона
+     *
+     * @exception std::bad_alloc Если диапазон длиннее Capacity
+     * @exception Любые исключения от конструктора T
+     */
+    template<std::input_iterator InputIt>
+    requires std::constructible_from<T, std::iter_reference_t<InputIt>>
+    constexpr StaticArray(InputIt first, InputIt last)
+        : sz(0)
+    {
+        if constexpr (std::forward_iterator<InputIt>) {
+            size_t n = static_cast<size_t>(std::distance(first, last));
+            check_capacity(n);
+            detail::construct_n_from(alloc, first, n, arr);
+            sz = n;
+        } else {
+            try {
+                for (; first != last; ++first) emplace_back(*first);
+            } catch (...) {
+                clear();
+                throw;
+            }
+        }
+    }
+
+    /**
+     * @brief Деструктор.
+     *
+     * Для тривиально уничтожаемых T деструктор тривиален. StaticArray работает в constexpr-функциях,
+     * но constexpr-переменная компилируется, только если массив заполнен целиком (size() == Capacity):
+     * элементы за size() не созданы, а значение constexpr-переменной должно быть полностью инициализировано.
+     *
+     * @exception Не бросает исключений
+     */
+    constexpr ~StaticArray() requires std::is_trivially_destructible_v<T> = default;
+    constexpr ~StaticArray() { clear(); }
+
+    /**
+     * @brief Конструктор копирования
+     * @param s_arr Другой StaticArray
+     *
+     * @exception Любые исключения от конструктора копирования T
+     */
+    constexpr StaticArray(const StaticArray& s_arr)
+    requires std::copy_constructible<T>
+        : sz(0)
+    {
+        detail::construct_n_from(alloc, s_arr.arr + 0, s_arr.sz, arr);
+        sz = s_arr.sz;
+    }
+
+    /**
+     * @brief Оператор присваивания копированием.
+     *
+     * Уже существующим элементам значения присваиваются, недостающие конструируются.
+     *
+     * @param s_arr Другой StaticArray
+     * @return StaticArray& Ссылка на этот массив
+     *
+     * @exception Любые исключения от конструктора или оператора присваивания копированием T
+     */
+    constexpr StaticArray& operator = (const StaticArray& s_arr)
+    requires std::copyable<T>
+    {
+        if (this != &s_arr) assign(s_arr.begin(), s_arr.end());
+        return *this;
+    }
+
+    /**
+     * @brief Конструктор перемещения
+     *
+     * Элементы перемещаются поштучно, s_arr остается пустым.
+     *
+     * @param s_arr Другой StaticArray
+     *
+     * @exception Любые исключения от конструктора перемещения T
+     */
+    constexpr StaticArray(StaticArray&& s_arr) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : sz(0)
+    {
+        detail::move_construct_n(alloc, s_arr.arr + 0, s_arr.sz, arr);
+        sz = s_arr.sz;
+        s_arr.clear();
+    }
+
+    /**
+     * @brief Оператор присваивания перемещением.
+     *
+     * Элементы перемещаются поштучно, s_arr остается пустым.
+     *
+     * @param s_arr Другой StaticArray
+     * @return StaticArray& Ссылка на этот массив
+     *
+     * @exception Любые исключения от конструктора или оператора присваивания перемещением T
+     */
+    constexpr StaticArray& operator = (StaticArray&& s_arr)
+    noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>)
+    requires std::movable<T>
+    {
+        if (this != &s_arr) {
+            assign(std::make_move_iterator(s_arr.begin()), std::make_move_iterator(s_arr.end()));
+            s_arr.clear();
+        }
+        return *this;
+    }
+
+    //CAPACITY BLOCK
+
+private:
+
+    /**
+     * @brief Проверяет, что required элементов помещается в массив.
+     *
+     * @exception std::bad_alloc Если required > Capacity
+     */
+    static constexpr void check_capacity(size_t required) {
+        if (required > Capacity) throw std::bad_alloc();
+    }
+
+public:
+
+    /**
+     * @brief Проверяет, что в массиве есть место под n элементов.
+     *
+     * Память не выделяется: метод нужен для совместимости с DynamicArray.
+     *
+     * @param n Требуемая ёмкость
+     *
+     * @exception std::bad_alloc Если n > Capacity
+     */
+    constexpr void reserve(size_t n) const { check_capacity(n); }
+
+    /**
+     * @brief Ничего не делает: ёмкость StaticArray фиксирована.
+     *
+     * @exception Не бросает исключений
+     */
+    constexpr void shrink_to_fit() const noexcept {}
+
+    //PUSH_BACK BLOCK
+
+    /**
+    * @brief Создает элемент на месте в конце массива.
+    *
+    * @tparam Args Типы аргументов для конструктора T
+    * @param args Аргументы для передачи конструктору T
+    *
+    * @exception std::bad_alloc Если массив заполнен
+    * @exception Любые исключения от конструктора T
+    */
+    template <typename... Args>
+    requires std::constructible_from<T, Args...>
+    constexpr void emplace_back(Args&&... args) {
+        check_capacity(sz + 1);
+        AllocatorTraits::construct(alloc, arr + sz, std::forward<Args>(args)...);
+        ++sz;
+    }
+
+    /**
+    * @brief Добавляет элемент в конец массива (копирование).
+    *
+    * @param value Элемент для копирования
+    *
+    * @exception std::bad_alloc Если массив заполнен
+    * @exception Любые исключения от конструктора копирования T
+    */
+    constexpr void push_back(const T& value)
+    requires std::copy_constructible<T>
+    {
+        emplace_back(value);
+    }
+
+    /**
+    * @brief Добавляет элемент в конец массива (перемещение).
+    *
+    * @param value Элемент для перемещения
+    *
+    * @exception std::bad_alloc Если массив заполнен
+    * @exception Любые исключения от конструктора перемещения T
+    */
+    constexpr void push_back(T&& value)
+    requires std::movable<T>
+    {
+        emplace_back(std::move(value));
+    }
+
+    //ERASE BLOCK
+
+    /**
+     * @brief Удаляет элемент в указанной позиции.
+     *
+     * @param pos Итератор на удаляемый элемент
+     * @return iterator Итератор на элемент после удаленного
+     *
+     * @exception Может бросать исключения от оператора перемещения T
+     */
+    constexpr iterator erase(iterator pos) {
+        return iterator(detail::erase_range(alloc, data(), sz, pos.base(), pos.base() + 1));
+    }
+
+    /**
+     * @brief Удаляет диапазон элементов [first, last).
+     *
+     * @param first Итератор на начало диапазона
+     * @param last Итератор на конец диапазона
+     * @return iterator Итератор на элемент после удаленного диапазона
+     *
+     * @exception Может бросать исключения от оператора перемещения T
+     */
+    constexpr iterator erase(iterator first, iterator last) {
+        return iterator(detail::erase_range(alloc, data(), sz, first.base(), last.base()));
+    }
+
+    //RESIZE AND POP_BACK BLOCK
+
+    /**
+     * @brief Изменяет размер массива с инициализацией значением (для копируемых типов).
+     *
+     * @param count Новый размер массива
+     * @param value Значение для инициализации новых элементов
+     *
+     * @exception std::bad_alloc Если count > Capacity
+     * @exception Любые исключения от конструктора копирования T
+     */
+    constexpr void resize(size_t count, const T& value = T())
+    requires std::copy_constructible<T>
+    {
+        if (count <= sz) {
+            shrink_to(count);
+            return;
+        }
+        check_capacity(count);
+        detail::construct_n_from(alloc, detail::fill_iterator<T>(&value, 0), count - sz, arr + sz);
+        sz = count;
+    }
+
+    /**
+     * @brief Изменяет размер массива (для некопируемых типов).
+     *
+     * @param count Новый размер массива
+     *
+     * @exception std::bad_alloc Если count > Capacity
+     * @exception Любые исключения от конструктора по умолчанию T
+     */
+    constexpr void resize(size_t count)
+    requires (!std::copy_constructible<T> && std::default_initializable<T>)
+    {
+        if (count <= sz) {
+            shrink_to(count);
+            return;
+        }
+        check_capacity(count);
+        size_t i = sz;
+        try {
+            for (; i < count; ++i) AllocatorTraits::construct(alloc, arr + i);
+        } catch (...) {
+            for (size_t j = sz; j < i; ++j) AllocatorTraits::destroy(alloc, arr + j);
+            throw;
+        }
+        sz = count;
+    }
+
+    /**
+     * @brief Изменяет размер массива, инициализируя новые элементы по умолчанию.
+     *
+     * Для тривиальных типов новые элементы остаются неинициализированными
+     * и должны быть перезаписаны до чтения.
+     *
+     * @param count Новый размер массива
+     *
+     * @exception std::bad_alloc Если count > Capacity
+     * @exception Любые исключения от дефолтного конструктора T
+     */
+    constexpr void resize_for_overwrite(size_t count)
+    requires std::default_initializable<T>
+    {
+        if (count <= sz) {
+            shrink_to(count);
+            return;
+        }
+        check_capacity(count);
+        detail::default_construct_n(alloc, arr + sz, count - sz);
+        sz = count;
+    }
+
+    /**
+     * @brief Увеличивает массив до count элементов и отдает их на заполнение операции op.
+     *
+     * Новые элементы инициализируются по умолчанию (для тривиальных типов - не трогаются),
+     * затем вызывается op(data(), count). Операция возвращает итоговый размер r <= count,
+     * элементы [r, size()) уничтожаются.
+     *
+     * @param count Размер буфера, доступного операции
+     * @param op Операция вида size_t(T* data, size_t count)
+     *
+     * @exception std::bad_alloc Если count > Capacity
+     * @exception Любые исключения от дефолтного конструктора T или от op
+     */
+    template<typename Operation>
+    requires std::default_initializable<T> &&
+             std::convertible_to<std::invoke_result_t<Operation&, T*, size_t>, size_t>
+    constexpr void resize_and_overwrite(size_t count, Operation op) {
+        if (count > sz) resize_for_overwrite(count);
+
+        size_t r = static_cast<size_t>(op(data(), count));
+        if (r > count) r = count;
+
+        shrink_to(r);
+    }
+
+    /**
+    * @brief Удаляет последний элемент массива.
+    *
+    * @exception Не бросает исключений
+    */
+    constexpr void pop_back() noexcept {
+        if(sz == 0) return;
+        --sz;
+        AllocatorTraits::destroy(alloc, arr + sz);
+    }
+
+private:
+
+    /**
+     * @brief Уничтожает элементы [count, size()).
+     *
+     * @exception Не бросает исключений
+     */
+    constexpr void shrink_to(size_t count) noexcept {
+        for (size_t i = count; i < sz; ++i) AllocatorTraits::destroy(alloc, arr + i);
+        sz = count;
+    }
+
+    /**
+     * @brief Вставляет n элементов из диапазона first в позицию idx.
+     *
+     * @return T* Указатель на первый вставленный элемент
+     *
+     * @exception std::bad_alloc Если size() + n > Capacity
+     * @exception Любые исключения от конструктора T или перемещения элементов
+     */
+    template<typename ForwardIt>
+    constexpr T* insert_range_n(size_t idx, ForwardIt first, size_t n) {
+        check_capacity(sz + n);
+        return detail::insert_n_in_place(alloc, data(), sz, idx, first, n);
+    }
+
+public:
+
+    //INSERTION BLOCK
+
+    /**
+    * @brief Создает элемент на месте в указанной позиции.
+    *
+    * @tparam Args Типы аргументов для конструктора T
+    * @param pos Итератор указывающий на позицию для вставки
+    * @param args Аргументы для передачи конструктору T
+    * @return iterator Итератор на вставленный элемент
+    *
+    * @exception std::bad_alloc Если массив заполнен
+    * @exception Любые исключения от конструктора T или перемещения элементов
+    */
+    template<typename... Args>
+    requires std::constructible_from<T, Args...>
+    constexpr iterator emplace(const_iterator pos, Args&&... args) {
+        size_t insertion_id = pos.base() - arr;
+        check_capacity(sz + 1);
+
+        if (insertion_id == sz) {
+            AllocatorTraits::construct(alloc, arr + sz, std::forward<Args>(args)...);
+            ++sz;
+            return iterator(arr + insertion_id);
+        }
+
+        // args могут ссылаться на элементы массива, которые затрет сдвиг хвоста
+        detail::temporary_value<T, Allocator> tmp(alloc, std::forward<Args>(args)...);
+        return iterator(insert_range_n(insertion_id, std::make_move_iterator(&tmp.get()), 1));
+    }
+
+    /**
+     * @brief Вставляет элемент в указанную позицию (копирование).
+     *
+     * @param pos Итератор указывающий на позицию для вставки
+     * @param value Значение для вставки
+     * @return iterator Итератор на вставленный элемент
+     *
+     * @exception std::bad_alloc Если массив заполнен
+     * @exception Любые исключения от конструктора копирования T
+     */
+    constexpr iterator insert(const_iterator pos, const T& value)
+    requires std::copy_constructible<T>
+    {
+        return emplace(pos, value);
+    }
+
+    /**
+     * @brief Вставляет элемент в указанную позицию (перемещение).
+     *
+     * @param pos Итератор указывающий на позицию для вставки
+     * @param value Значение для вставки
+     * @return iterator Итератор на вставленный элемент
+     *
+     * @exception std::bad_alloc Если массив заполнен
+     * @exception Любые исключения от конструктора перемещения T
+     */
+    constexpr iterator insert(const_iterator pos, T&& value)
+    requires std::movable<T>
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    /**
+     * @brief Вставляет n копий значения в указанную позицию.
+     *
+     * @param pos Итератор указывающий на позицию для вставки
+     * @param n Количество копий
+     * @param value Значение для копирования
+     * @return iterator Итератор на первый вставленный элемент
+     *
+     * @exception std::bad_alloc Если size() + n > Capacity
+     * @exception Любые исключения от конструктора копирования T
+     */
+    constexpr iterator insert(const_iterator pos, size_t n, const T& value)
+    requires std::copy_constructible<T>
+    {
+        // value может указывать внутрь массива, а сдвиг хвоста его затрет
+        const T copy(value);
+        return iterator(insert_range_n(pos.base() - arr, detail::fill_iterator<T>(&copy, 0), n));
+    }
+
+    /**
+     * @brief Вставляет диапазон [first, last) в указанную позицию.
+     *
+     * @param pos Итератор указывающий на позицию для вставки
+     * @param first Итератор на начало диапазона (не должен указывать внутрь массива)
+     * @param last Итератор на конец диапазона
+     * @return iterator Итератор на первый вставленный элемент
+     *
+     * @exception std::bad_alloc Если size() + длина диапазона > Capacity
+     * @exception Любые исключения от конструктора T или перемещения элементов
+     */
+    template<std::input_iterator InputIt>
+    requires std::constructible_from<T, std::iter_reference_t<InputIt>>
+    constexpr iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        size_t idx = pos.base() - arr;
+        if constexpr (std::forward_iterator<InputIt>) {
+            return iterator(insert_range_n(idx, first, static_cast<size_t>(std::distance(first, last))));
+        } else {
+            // Однопроходный диапазон: сначала собираем его, чтобы узнать размер
+            StaticArray buffer(first, last);
+            return iterator(insert_range_n(idx, std::make_move_iterator(buffer.data()), buffer.sz));
+        }
+    }
+
+    //ASSIGN AND APPEND BLOCK
+
+    /**
+     * @brief Добавляет элементы диапазона в конец массива.
+     *
+     * @param rg Диапазон элементов
+     *
+     * @exception std::bad_alloc Если элементы не помещаются в массив
+     * @exception Любые исключения от конструктора T
+     */
+    template<std::ranges::input_range R>
+    requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+    constexpr void append_range(R&& rg) {
+        if constexpr (std::ranges::forward_range<R>) {
+            insert_range_n(sz, std::ranges::begin(rg), static_cast<size_t>(std::ranges::distance(rg)));
+        } else {
+            // Однопроходный диапазон читаем один раз (его итератор может быть только перемещаемым),
+            // но если размер известен заранее - переполнение проверяем до вставки первого элемента
+            if constexpr (std::ranges::sized_range<R>) reserve(sz + static_cast<size_t>(std::ranges::size(rg)));
+            for (auto&& value : rg) emplace_back(std::forward<decltype(value)>(value));
+        }
+    }
+
+    /**
+     * @brief Заменяет содержимое массива элементами диапазона [first, last).
+     *
+     * @param first Итератор на начало диапазона (не должен указывать внутрь массива)
+     * @param last Итератор на конец диапазона
+     *
+     * @exception std::bad_alloc Если диапазон длиннее Capacity
+     * @exception Любые исключения от конструктора или оператора присваивания T
+     */
+    template<std::input_iterator InputIt>
+    requires std::constructible_from<T, std::iter_reference_t<InputIt>>
+    constexpr void assign(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            size_t n = static_cast<size_t>(std::distance(first, last));
+            check_capacity(n);
+
+            if (n <= sz) {
+                detail::assign_n_from<T, Allocator>(first, n, data());
+                shrink_to(n);
+            } else {
+                InputIt mid = std::next(first, sz);
+                detail::assign_n_from<T, Allocator>(first, sz, data());
+                detail::construct_n_from(alloc, mid, n - sz, arr + sz);
+                sz = n;
+            }
+        } else {
+            clear();
+            for (; first != last; ++first) emplace_back(*first);
+        }
+    }
+
+    //ETC BLOCK
+    /**
+     * @brief Возвращает размер массива.
+     *
+     * @return size_t Количество элементов в массиве
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] constexpr size_t size() const noexcept { return sz; }
+
+    /**
+     * @brief Возвращает ёмкость массива.
+     *
+     * @return size_t Capacity
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+    /**
+     * @brief Проверяет пуст ли массив.
+     *
+     * @return true если массив пуст, false иначе
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept { return sz == 0; }
+
+    /**
+     * @brief Доступ к элементу по индексу без проверки границ.
+     *
+     * @param i Индекс элемента
+     * @return T& Ссылка на элемент
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] constexpr T& operator[] (size_t i) noexcept { return arr[i]; }
+    [[nodiscard]] constexpr const T& operator[] (size_t i) const noexcept { return arr[i]; }
+
+    /**
+     * @brief Возвращает ссылку на первый элемент массива.
+     *
+     * @return T& Ссылка на первый элемент
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] constexpr T& front() noexcept { return arr[0]; }
+    [[nodiscard]] constexpr const T& front() const noexcept { return arr[0]; }
+
+    /**
+     * @brief Возвращает ссылку на последний элемент массива.
+     *
+     * @return T& Ссылка на последний элемент
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] constexpr T& back() noexcept { return arr[sz-1]; }
+    [[nodiscard]] constexpr const T& back() const noexcept { return arr[sz-1]; }
+
+    /**
+     * @brief Возвращает указатель на данные массива.
+     *
+     * @return T* Указатель на данные массива
+     *
+     * @exception Не бросает исключений
+     */
+    [[nodiscard]] constexpr T* data() noexcept { return arr; }
+    [[nodiscard]] constexpr const T* data() const noexcept { return arr; }
+
+    /**
+     * @brief Доступ к элементу по индексу с проверкой границ.
+     *
+     * @param i Индекс элемента
+     * @return T& Ссылка на элемент
+     *
+     * @exception std::out_of_range Если индекс >= size()
+     */
+    [[nodiscard]]
+    constexpr T& at(size_t i) {
+        if (i >= sz) throw std::out_of_range("Index out of range");
+        return arr[i];
+    }
+
+    [[nodiscard]]
+    constexpr const T& at(size_t i) const {
+        if (i >= sz) throw std::out_of_range("Index out of range");
+        return arr[i];
+    }
+
+    /**
+    * @brief Удаляет все элементы из массива.
+    *
+    * @exception Не бросает исключений
+    */
+    constexpr void clear() noexcept { shrink_to(0); }
+
+    /**
+    * @brief Обменивает содержимое двух массивов.
+    *
+    * Общая часть обменивается поэлементно, хвост длинного массива переносится в короткий.
+    *
+    * @param other Массив для обмена
+    *
+    * @exception Любые исключения от обмена или конструктора перемещения T
+    */
+    constexpr void swap(StaticArray& other)
+    noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>)
+    {
+        if(this == &other) return;
+
+        StaticArray& shorter = sz < other.sz ? *this : other;
+        StaticArray& longer = sz < other.sz ? other : *this;
+
+        size_t common = shorter.sz;
+        for (size_t i = 0; i < common; ++i) {
+            using std::swap;
+            swap(arr[i], other.arr[i]);
+        }
+
+        detail::move_construct_n(alloc, longer.arr + common, longer.sz - common, shorter.arr + common);
+        shorter.sz = longer.sz;
+        longer.shrink_to(common);
+    }
+};
+
+} // namespace mystl
+
+#endif // STATICARRAY_HPP
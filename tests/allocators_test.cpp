@@ -0,0 +1,260 @@
+// Аллокаторы с состоянием (ArenaAllocator, PoolAllocator) в DynamicArray и Map:
+// распространение при копировании, перемещении и swap(), перемещение между неравными аллокаторами,
+// get_allocator(). Без фреймворка: при ошибке печатается условие и код возврата ненулевой.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "ArenaAllocator.hpp"
+#include "DynamicArray.hpp"
+#include "Map.hpp"
+#include "PoolAllocator.hpp"
+
+#define CHECK(cond)                                                                 \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            std::exit(1);                                                           \
+        }                                                                           \
+    } while (false)
+
+using namespace mystl;
+
+namespace {
+
+/**
+ * @brief PropagatingArenaAllocator - ArenaAllocator, который распространяется при присваивании и swap()
+ */
+template<typename T>
+class PropagatingArenaAllocator : public ArenaAllocator<T> {
+public:
+
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<typename U>
+    struct rebind { using other = PropagatingArenaAllocator<U>; };
+
+    PropagatingArenaAllocator(Arena& arena) noexcept : ArenaAllocator<T>(arena) {}
+
+    template<typename U>
+    PropagatingArenaAllocator(const PropagatingArenaAllocator<U>& other) noexcept : ArenaAllocator<T>(other) {}
+};
+
+std::string value_for(int i) { return "value number " + std::to_string(i); }  // длиннее SSO-буфера
+
+template<typename Array>
+void fill(Array& arr, int count, int shift = 0) {
+    for (int i = 0; i < count; ++i) arr.push_back(value_for(i + shift));
+}
+
+template<typename Array>
+bool holds(const Array& arr, int count, int shift = 0) {
+    if (arr.size() != static_cast<std::size_t>(count)) return false;
+    for (int i = 0; i < count; ++i) if (arr[i] != value_for(i + shift)) return false;
+    return true;
+}
+
+template<typename M>
+void fill_map(M& m, int count, int shift = 0) {
+    for (int i = 0; i < count; ++i) m.emplace(i + shift, value_for(i + shift));
+}
+
+template<typename M>
+bool holds_map(const M& m, int count, int shift = 0) {
+    if (m.size() != static_cast<std::size_t>(count)) return false;
+    int i = shift;
+    for (const auto& [key, value] : m) {
+        if (key != i || value != value_for(i)) return false;
+        ++i;
+    }
+    return true;
+}
+
+//DYNAMIC ARRAY BLOCK
+
+/**
+ * @brief Массив на ArenaAllocator не уходит со своей арены: присваивание копирует и перемещает элементы
+ */
+void array_arena_stays() {
+    using A = ArenaAllocator<std::string>;
+    Arena first, second;
+
+    DynamicArray<std::string, A> a{A(first)}, b{A(second)};
+    fill(a, 100);
+    fill(b, 50, 1000);
+    CHECK(a.get_allocator() == A(first));
+
+    a = b;
+    CHECK(holds(a, 50, 1000) && holds(b, 50, 1000));
+    CHECK(a.get_allocator() == A(first));
+
+    a = std::move(b);
+    CHECK(holds(a, 50, 1000));
+    CHECK(a.get_allocator() == A(first) && b.get_allocator() == A(second));
+
+    // Копия получает select_on_container_copy_construction() - для ArenaAllocator ту же арену
+    DynamicArray<std::string, A> c(a);
+    CHECK(holds(c, 50, 1000) && c.get_allocator() == A(first));
+
+    // Перемещение с неравным аллокатором: элементы переносятся на вторую арену
+    DynamicArray<std::string, A> d(std::move(c), A(second));
+    CHECK(holds(d, 50, 1000) && d.get_allocator() == A(second));
+
+    // Перемещение с равным аллокатором забирает буфер целиком
+    const std::string* data = a.data();
+    DynamicArray<std::string, A> e(std::move(a), A(first));
+    CHECK(e.data() == data && holds(e, 50, 1000));
+}
+
+/**
+ * @brief При propagate_on_container_* аллокатор следует за содержимым
+ */
+void array_propagation() {
+    using A = PropagatingArenaAllocator<std::string>;
+    Arena first, second;
+
+    DynamicArray<std::string, A> a{A(first)}, b{A(second)};
+    fill(a, 10);
+    fill(b, 20, 100);
+
+    a = b;
+    CHECK(holds(a, 20, 100) && a.get_allocator() == A(second));
+
+    DynamicArray<std::string, A> c{A(first)};
+    const std::string* data = b.data();
+    c = std::move(b);
+    CHECK(holds(c, 20, 100) && c.data() == data && c.get_allocator() == A(second));
+
+    DynamicArray<std::string, A> d{A(first)};
+    fill(d, 5, 7);
+    d.swap(c);
+    CHECK(holds(d, 20, 100) && d.get_allocator() == A(second));
+    CHECK(holds(c, 5, 7) && c.get_allocator() == A(first));
+}
+
+/**
+ * @brief swap() массивов на одном пуле и перемещение между пулами
+ */
+void array_pool() {
+    using A = PoolAllocator<std::string>;
+    Pool first, second;
+
+    DynamicArray<std::string, A> a{A(first)}, b{A(first)};
+    fill(a, 30);
+    fill(b, 3, 500);
+    CHECK(a.get_allocator() == b.get_allocator());
+
+    a.swap(b);
+    CHECK(holds(a, 3, 500) && holds(b, 30));
+
+    DynamicArray<std::string, A> c{A(second)};
+    c = std::move(b);
+    CHECK(holds(c, 30) && c.get_allocator() == A(second));
+}
+
+//MAP BLOCK
+
+/**
+ * @brief Map на PoolAllocator не уходит со своего пула: узлы создаются заново
+ */
+void map_pool_stays() {
+    using A = PoolAllocator<std::pair<const int, std::string>>;
+    using M = Map<int, std::string, std::less<int>, A>;
+    Pool first, second;
+
+    M a{A(first)};
+    fill_map(a, 200);
+    CHECK(a.get_allocator() == A(first));
+    {
+        M b{A(second)};
+        fill_map(b, 100, 1000);
+
+        a = b;
+        CHECK(holds_map(a, 100, 1000) && holds_map(b, 100, 1000));
+        CHECK(a.get_allocator() == A(first));
+
+        a = std::move(b);
+        CHECK(holds_map(a, 100, 1000) && b.empty());
+        CHECK(a.get_allocator() == A(first) && b.get_allocator() == A(second));
+        a.invariants_checker();
+    }
+
+    // Ни один узел a не лежит во втором пуле
+    second.release();
+    CHECK(holds_map(a, 100, 1000));
+
+    M c(std::move(a), A(second));
+    CHECK(holds_map(c, 100, 1000) && c.get_allocator() == A(second));
+    c.invariants_checker();
+}
+
+/**
+ * @brief При propagate_on_container_* аллокатор Map следует за содержимым
+ */
+void map_propagation() {
+    using A = PropagatingArenaAllocator<std::pair<const int, std::string>>;
+    using M = Map<int, std::string, std::less<int>, A>;
+    Arena first, second;
+
+    M a{A(first)}, b{A(second)};
+    fill_map(a, 10);
+    fill_map(b, 40, 100);
+
+    a = b;
+    CHECK(holds_map(a, 40, 100) && a.get_allocator() == A(second));
+
+    M c{A(first)};
+    c = std::move(b);
+    CHECK(holds_map(c, 40, 100) && c.get_allocator() == A(second) && b.empty());
+
+    M d{A(first)};
+    fill_map(d, 5, 7);
+    d.swap(c);
+    CHECK(holds_map(d, 40, 100) && d.get_allocator() == A(second));
+    CHECK(holds_map(c, 5, 7) && c.get_allocator() == A(first));
+    c.invariants_checker();
+    d.invariants_checker();
+}
+
+/**
+ * @brief swap() и merge() для Map на одной арене и на разных аренах
+ */
+void map_arena_swap_merge() {
+    using A = ArenaAllocator<std::pair<const int, std::string>>;
+    using M = Map<int, std::string, std::less<int>, A>;
+    Arena first, second;
+
+    M a{A(first)}, b{A(first)};
+    fill_map(a, 50);
+    fill_map(b, 20, 50);
+    a.swap(b);
+    CHECK(holds_map(a, 20, 50) && holds_map(b, 50));
+
+    // merge() из Map на другой арене переносит элементы в новые узлы
+    M c{A(second)};
+    fill_map(c, 30, 70);
+    a.merge(c);
+    CHECK(holds_map(a, 50, 50) && c.empty());
+    CHECK(a.get_allocator() == A(first));
+    a.invariants_checker();
+}
+
+} // namespace
+
+int main() {
+    array_arena_stays();
+    array_propagation();
+    array_pool();
+    map_pool_stays();
+    map_propagation();
+    map_arena_swap_merge();
+    std::puts("allocators: ok");
+    return 0;
+}